@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name` IN ('mmap','mmap stats');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('mmap',2,'Syntax: .mmap $subcommand\nType .mmap to see the list of possible subcommands or .help mmap $subcommand to see info on subcommands'),
+('mmap stats',2,'Syntax: .mmap stats\nShow navmesh tile statistics: loaded maps and tiles, tile memory and budget, tile loads, evictions and load times.');
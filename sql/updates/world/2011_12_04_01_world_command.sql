@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug vmapcache';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug vmapcache',3,'Syntax: .debug vmapcache\nShow hit rate and estimated saved time of the vmap line of sight and height caches.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug objectlookups';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug objectlookups',3,'Syntax: .debug objectlookups\nShow how many global object lookups had to wait for an object being added or removed, per object type.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug objectlookups';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug objectlookups',3,'Syntax: .debug objectlookups\nShow how many object lookups went through the global object registries and how many of them had to wait for an object being added or removed, per object type. When used in game, also show how many lookups were answered by your current map''s own object store.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug mapstats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug mapstats',3,'Syntax: .debug mapstats\nShow how many dead creatures of your current map are waiting in its respawn schedule.');
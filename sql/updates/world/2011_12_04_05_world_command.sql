@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug mapstats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug mapstats',3,'Syntax: .debug mapstats\nShow how many creatures are in world on your current map, how many of them are dormant (skipping their updates while idle) and how many dead creatures are waiting in its respawn schedule.');
@@ -30,8 +30,11 @@
 #include "SystemConfig.h"
 #include "Util.h"
 #include "SignalHandler.h"
+#include "Threading.h"
 #include "RealmList.h"
 #include "RealmAcceptor.h"
+#include "AuthSocket.h"
+#include "OpenSSLCrypto.h"
 
 #ifndef _TRINITY_REALM_CONFIG
 # define _TRINITY_REALM_CONFIG  "authserver.conf"
@@ -60,6 +63,32 @@ public:
     }
 };
 
+// Runs the reactor event loop on an additional network thread, so a client waiting
+// on a login database query does not hold up the sockets handled by the other threads
+class AuthReactorRunnable : public ACE_Based::Runnable
+{
+public:
+    void run()
+    {
+        MySQL::Thread_Init();
+
+        while (!stopEvent)
+        {
+            // dont move this outside the loop, the reactor will modify it
+            ACE_Time_Value interval(0, 100000);
+
+            if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
+            {
+                sLog->outError("Network thread reactor event loop failed, stopping the auth server.");
+                stopEvent = true;
+                break;
+            }
+        }
+
+        MySQL::Thread_End();
+    }
+};
+
 /// Print out the usage string for this program on the console.
 void usage(const char *prog)
 {
@@ -105,6 +134,9 @@ extern int main(int argc, char **argv)
 
     sLog->outDetail("%s (Library: %s)", OPENSSL_VERSION_TEXT, SSLeay_version(SSLEAY_VERSION));
 
+    // Network threads run SRP6 math concurrently, give OpenSSL its locks first
+    OpenSSLCrypto::threadsSetup();
+
 #if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
     ACE_Reactor::instance(new ACE_Reactor(new ACE_Dev_Poll_Reactor(ACE::max_handles(), 1), 1), true);
 #else
@@ -208,6 +240,10 @@ extern int main(int argc, char **argv)
     uint32 numLoops = (ConfigMgr::GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000000 / 100000));
     uint32 loopCounter = 0;
 
+    // login statistics are reported once a minute
+    uint32 statsLoops = MINUTE * 1000000 / 100000;
+    uint32 statsCounter = 0;
+
     // possibly enable db logging; avoid massive startup spam by doing it here.
     if (sLog->GetLogDBLater())
     {
@@ -219,6 +255,21 @@ extern int main(int argc, char **argv)
     else
         sLog->SetLogDB(false);
 
+    // The main thread runs the reactor too, every extra thread handles events in parallel with it
+    uint32 networkThreads = ConfigMgr::GetIntDefault("Network.Threads", 1);
+    if (networkThreads < 1 || networkThreads > 32)
+    {
+        sLog->outError("Improper value specified for Network.Threads, defaulting to 1.");
+        networkThreads = 1;
+    }
+
+    std::vector<ACE_Based::Thread*> reactorThreads;
+    for (uint32 i = 1; i < networkThreads; ++i)
+        reactorThreads.push_back(new ACE_Based::Thread(new AuthReactorRunnable));
+
+    if (networkThreads > 1)
+        sLog->outString("Handling connections with %u network threads", networkThreads);
+
     // Wait for termination signal
     while (!stopEvent)
     {
@@ -234,8 +285,24 @@ extern int main(int argc, char **argv)
             sLog->outDetail("Ping MySQL to keep connection alive");
             LoginDatabase.KeepAlive();
         }
+
+        if ((++statsCounter) == statsLoops)
+        {
+            statsCounter = 0;
+            AuthSocket::ReportLoginStats(MINUTE);
+        }
+    }
+
+    // Stop the other network threads before the database goes away under them
+    stopEvent = true;
+    for (std::vector<ACE_Based::Thread*>::iterator itr = reactorThreads.begin(); itr != reactorThreads.end(); ++itr)
+    {
+        (*itr)->wait();
+        delete *itr;
     }
 
+    OpenSSLCrypto::threadsCleanup();
+
     // Close the Database Pool and library
     StopDB();
 
@@ -269,7 +336,7 @@ bool StartDB()
         synch_threads = 1;
     }
 
-    // NOTE: While authserver is singlethreaded you should keep synch_threads == 1. Increasing it is just silly since only 1 will be used ever.
+    // NOTE: Each network thread may hold a synchronous connection while it waits for a query, keep synch_threads >= Network.Threads
     if (!LoginDatabase.Open(dbstring.c_str(), worker_threads, synch_threads))
     {
         sLog->outError("Cannot connect to database");
@@ -28,13 +28,13 @@ void RealmList::Initialize(uint32 updateInterval)
     m_UpdateInterval = updateInterval;
 
     // Get the content of the realmlist table in the database
-    UpdateRealms(true);
+    UpdateRealms(m_realms, true);
 }
 
-void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, uint8 color, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build)
+void RealmList::UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, uint8 color, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build)
 {
     // Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    Realm& realm = realms[name];
 
     realm.m_ID = ID;
     realm.name = name;
@@ -53,20 +53,31 @@ void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::strin
 
 void RealmList::UpdateIfNeed()
 {
-    // maybe disabled or updated recently
-    if (!m_UpdateInterval || m_NextUpdateTime > time(NULL))
-        return;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_lock);
+
+        // maybe disabled or updated recently
+        if (!m_UpdateInterval || m_NextUpdateTime > time(NULL))
+            return;
 
-    m_NextUpdateTime = time(NULL) + m_UpdateInterval;
+        m_NextUpdateTime = time(NULL) + m_UpdateInterval;
+    }
 
-    // Clears Realm list
-    m_realms.clear();
+    // Load the new list without holding the lock, the other network threads keep sending the current one meanwhile
+    RealmMap realms;
+    UpdateRealms(realms);
 
-    // Get the content of the realmlist table in the database
-    UpdateRealms();
+    TRINITY_GUARD(ACE_Thread_Mutex, m_lock);
+    m_realms.swap(realms);
+}
+
+RealmList::RealmMap RealmList::GetRealms()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_lock);
+    return m_realms;
 }
 
-void RealmList::UpdateRealms(bool init)
+void RealmList::UpdateRealms(RealmMap& realms, bool init)
 {
     sLog->outDetail("Updating Realm List...");
 
@@ -90,7 +101,7 @@ void RealmList::UpdateRealms(bool init)
             float pop = fields[8].GetFloat();
             uint32 build = fields[9].GetUInt32();
 
-            UpdateRealm(realmId, name, address, port, icon, color, timezone, (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR), pop, build);
+            UpdateRealm(realms, realmId, name, address, port, icon, color, timezone, (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR), pop, build);
 
             if (init)
                 sLog->outString("Added realm \"%s\".", fields[1].GetCString());
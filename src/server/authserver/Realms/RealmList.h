@@ -21,6 +21,7 @@
 
 #include <ace/Singleton.h>
 #include <ace/Null_Mutex.h>
+#include <ace/Thread_Mutex.h>
 #include "Common.h"
 
 // Storage object for a realm
@@ -56,11 +57,15 @@ public:
     RealmMap::const_iterator end() const { return m_realms.end(); }
     uint32 size() const { return m_realms.size(); }
 
+    // network threads must work on a copy, UpdateIfNeed may rebuild the list meanwhile
+    RealmMap GetRealms();
+
 private:
-    void UpdateRealms(bool init=false);
-    void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, uint8 color, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build);
+    void UpdateRealms(RealmMap& realms, bool init=false);
+    void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, uint8 color, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build);
 
     RealmMap m_realms;
+    ACE_Thread_Mutex m_lock;
     uint32   m_UpdateInterval;
     time_t   m_NextUpdateTime;
 };
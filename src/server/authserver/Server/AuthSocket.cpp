@@ -27,8 +27,11 @@
 #include "AuthSocket.h"
 #include "AuthCodes.h"
 #include "SHA1.h"
+#include "Timer.h"
 #include "openssl/crypto.h"
 
+#include <ace/Atomic_Op.h>
+
 #define ChunkSize 2048
 
 enum eAuthCmd
@@ -194,12 +197,41 @@ const AuthHandler table[] =
 // Holds the MD5 hash of client patches present on the server
 Patcher PatchesCache;
 
+// Login counters shared by the sockets of all network threads
+typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> LoginCounter;
+
+static LoginCounter s_challenges;
+static LoginCounter s_acceptedProofs;
+static LoginCounter s_rejectedProofs;
+static LoginCounter s_loginTime;                            // ms from challenge to accepted proof, summed
+
+void AuthSocket::ReportLoginStats(uint32 period)
+{
+    long challenges = s_challenges.value();
+    long accepted = s_acceptedProofs.value();
+    long rejected = s_rejectedProofs.value();
+    long loginTime = s_loginTime.value();
+
+    s_challenges -= challenges;
+    s_acceptedProofs -= accepted;
+    s_rejectedProofs -= rejected;
+    s_loginTime -= loginTime;
+
+    if (!challenges && !accepted && !rejected)
+        return;
+
+    sLog->outDetail("Logins in the last %u seconds: %ld challenges, %ld accepted (%ld ms average handshake), %ld rejected",
+        period, challenges, accepted, accepted ? loginTime / accepted : 0, rejected);
+}
+
 // Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(RealmSocket& socket) : socket_(socket)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
     _authed = false;
+    _challengeTime = 0;
+    _accountId = 0;
     _accountSecurityLevel = SEC_PLAYER;
 }
 
@@ -300,6 +332,9 @@ bool AuthSocket::_HandleLogonChallenge()
     if (socket().recv_len() < sizeof(sAuthLogonChallenge_C))
         return false;
 
+    ++s_challenges;
+    _challengeTime = getMSTime();
+
     // Read the first 4 bytes (header) to get the length of the remaining of the packet
     std::vector<uint8> buf;
     buf.resize(4);
@@ -370,6 +405,7 @@ bool AuthSocket::_HandleLogonChallenge()
         if (res2)
         {
             Field* fields = res2->Fetch();
+            _accountId = fields[1].GetUInt32();
 
             // If the IP is 'locked', check that the player comes indeed from the correct IP address
             bool locked = false;
@@ -632,12 +668,17 @@ bool AuthSocket::_HandleLogonProof()
         }
 
         _authed = true;
+
+        ++s_acceptedProofs;
+        s_loginTime += long(GetMSTimeDiffToNow(_challengeTime));
     }
     else
     {
         char data[4] = { AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0 };
         socket().send(data, sizeof(data));
 
+        ++s_rejectedProofs;
+
         sLog->outBasic("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str());
 
         uint32 MaxWrongPassCount = ConfigMgr::GetIntDefault("WrongPass.MaxCount", 0);
@@ -740,6 +781,7 @@ bool AuthSocket::_HandleReconnectChallenge()
     _expversion = (AuthHelper::IsPostBCAcceptedClientBuild(_build) ? POST_BC_EXP_FLAG : NO_VALID_EXP_FLAG) | (AuthHelper::IsPreBCAcceptedClientBuild(_build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG);
 
     Field* fields = result->Fetch();
+    _accountId = fields[1].GetUInt32();
     uint8 secLevel = fields[2].GetUInt8();
     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
@@ -805,29 +847,37 @@ bool AuthSocket::_HandleRealmList()
 
     socket().recv_skip(5);
 
-    // Get the user id (else close the connection)
-    // No SQL injection (prepared statement)
-    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_GET_ACCIDBYNAME);
-    stmt->setString(0, _login);
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
-    if (!result)
+    // The account id was read with the logon or reconnect challenge
+    if (!_accountId)
     {
-        sLog->outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
+        sLog->outError("[ERROR] user %s requested the realm list without an account.", _login.c_str());
         socket().shutdown();
         return false;
     }
 
-    Field* fields = result->Fetch();
-    uint32 id = fields[0].GetUInt32();
+    // Character counts of the account on all realms, in a single query
+    std::map<uint32, uint8> characterCounts;
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_GET_NUMCHARSONREALMS);
+    stmt->setUInt32(0, _accountId);
+    if (PreparedQueryResult result = LoginDatabase.Query(stmt))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        }
+        while (result->NextRow());
+    }
 
     // Update realm list if need
     sRealmList->UpdateIfNeed();
+    RealmList::RealmMap realms = sRealmList->GetRealms();
 
     // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
 
     size_t RealmListSize = 0;
-    for (RealmList::RealmMap::const_iterator i = sRealmList->begin(); i != sRealmList->end(); ++i)
+    for (RealmList::RealmMap::const_iterator i = realms.begin(); i != realms.end(); ++i)
     {
         // don't work with realms which not compatible with the client
         if ((_expversion & POST_BC_EXP_FLAG) && i->second.gamebuild != _build)
@@ -835,17 +885,8 @@ bool AuthSocket::_HandleRealmList()
         else if ((_expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(i->second.gamebuild))
                 continue;
 
-        uint8 AmountOfCharacters;
-
-        // No SQL injection. id of realm is controlled by the database.
-        stmt = LoginDatabase.GetPreparedStatement(LOGIN_GET_NUMCHARSONREALM);
-        stmt->setUInt32(0, i->second.m_ID);
-        stmt->setUInt32(1, id);
-        result = LoginDatabase.Query(stmt);
-        if (result)
-            AmountOfCharacters = (*result)[0].GetUInt8();
-        else
-            AmountOfCharacters = 0;
+        std::map<uint32, uint8>::const_iterator count = characterCounts.find(i->second.m_ID);
+        uint8 AmountOfCharacters = count != characterCounts.end() ? count->second : 0;
 
         uint8 lock = (i->second.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
 
@@ -62,6 +62,9 @@ public:
 
     void _SetVSFields(const std::string& rI);
 
+    // Logs the login counters gathered by all sockets over the last period and resets them
+    static void ReportLoginStats(uint32 period);
+
     FILE* pPatch;
     ACE_Thread_Mutex patcherLock;
 
@@ -75,8 +78,10 @@ private:
     BigNumber _reconnectProof;
 
     bool _authed;
+    uint32 _challengeTime;                                  // getMSTime() when the logon challenge arrived
 
     std::string _login;
+    uint32 _accountId;
 
     // Since GetLocaleByName() is _NOT_ bijective, we have to store the locale as a string. Otherwise we can't differ
     // between enUS and enGB, which is important for the patch system
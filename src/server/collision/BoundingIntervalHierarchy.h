@@ -24,6 +24,7 @@
 #include "G3D/AABox.h"
 
 #include "Define.h"
+#include "RayPacket.h"
 
 #include <stdexcept>
 #include <vector>
@@ -121,36 +122,14 @@ class BIH
         template<typename RayCallback>
         void intersectRay(const Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
         {
-            float intervalMin = -1.f;
-            float intervalMax = -1.f;
+            float intervalMin;
+            float intervalMax;
             Vector3 org = r.origin();
             Vector3 dir = r.direction();
-            Vector3 invDir;
-            for (int i=0; i<3; ++i)
-            {
-                invDir[i] = 1.f / dir[i];
-                if (G3D::fuzzyNe(dir[i], 0.0f))
-                {
-                    float t1 = (bounds.low()[i]  - org[i]) * invDir[i];
-                    float t2 = (bounds.high()[i] - org[i]) * invDir[i];
-                    if (t1 > t2)
-                        std::swap(t1, t2);
-                    if (t1 > intervalMin)
-                        intervalMin = t1;
-                    if (t2 < intervalMax || intervalMax < 0.f)
-                        intervalMax = t2;
-                    // intervalMax can only become smaller for other axis,
-                    //  and intervalMin only larger respectively, so stop early
-                    if (intervalMax <= 0 || intervalMin >= maxDist)
-                        return;
-                }
-            }
-
-            if (intervalMin > intervalMax)
+            if (!clipRay(org, dir, maxDist, intervalMin, intervalMax))
                 return;
-            intervalMin = std::max(intervalMin, 0.f);
-            intervalMax = std::min(intervalMax, maxDist);
 
+            Vector3 invDir;
             uint32 offsetFront[3];
             uint32 offsetBack[3];
             uint32 offsetFront3[3];
@@ -159,6 +138,7 @@ class BIH
 
             for (int i=0; i<3; ++i)
             {
+                invDir[i] = 1.f / dir[i];
                 offsetFront[i] = floatToRawIntBits(dir[i]) >> 31;
                 offsetBack[i] = offsetFront[i] ^ 1;
                 offsetFront3[i] = offsetFront[i] * 3;
@@ -257,6 +237,151 @@ class BIH
             }
         }
 
+        /** Traces up to RAY_PACKET_SIZE rays at once, lanes selects the rays of the packet to trace.
+            The callback is invoked as callback(packet, activeLanes, entry, maxDist, stopAtFirst) and
+            returns the lanes that hit; maxDist holds one distance per lane. Nodes are visited as long
+            as any lane still crosses them, so coherent rays share most of the traversal work. */
+        template<typename RayPacketCallback>
+        void intersectRayPacket(const RayPacket &packet, uint32 lanes, RayPacketCallback& intersectCallback, float* maxDist, bool stopAtFirst=false) const
+        {
+            float startMin[RAY_PACKET_SIZE];
+            float startMax[RAY_PACKET_SIZE];
+            for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+            {
+                if (!(lanes & (1 << i)) || !clipRay(packet.rays[i].origin(), packet.rays[i].direction(), maxDist[i], startMin[i], startMax[i]))
+                {
+                    // empty interval
+                    lanes &= ~(1 << i);
+                    startMin[i] = 1.f;
+                    startMax[i] = 0.f;
+                }
+            }
+
+            if (!lanes)
+                return;
+
+            PacketFloat intervalMin(startMin[0], startMin[1], startMin[2], startMin[3]);
+            PacketFloat intervalMax(startMax[0], startMax[1], startMax[2], startMax[3]);
+
+            // per lane direction sign, and the child to visit first for the packet as a whole
+            PacketMask negDir[3] = { packet.invDir[0] < PacketFloat(0.f), packet.invDir[1] < PacketFloat(0.f), packet.invDir[2] < PacketFloat(0.f) };
+            bool rightFirst[3];
+            for (int i = 0; i < 3; ++i)
+                rightFirst[i] = activeCount(negDir[i].bits() & lanes) * 2 > activeCount(lanes);
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+            uint32 finished = 0;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 active = (intervalMin <= intervalMax).bits() & lanes & ~finished;
+                    if (!active)
+                        break;
+
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = tn & (1 << 29);
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, left child covers [.., tl], right child [tr, ..] on this axis
+                            PacketFloat tl = (PacketFloat(intBitsToFloat(tree[node + 1])) - packet.org[axis]) * packet.invDir[axis];
+                            PacketFloat tr = (PacketFloat(intBitsToFloat(tree[node + 2])) - packet.org[axis]) * packet.invDir[axis];
+                            // NaN (ray on a clip plane) keeps the current interval
+                            PacketFloat leftMin = PacketFloat::select(negDir[axis], PacketFloat::max(tl, intervalMin), intervalMin);
+                            PacketFloat leftMax = PacketFloat::select(negDir[axis], intervalMax, PacketFloat::min(tl, intervalMax));
+                            PacketFloat rightMin = PacketFloat::select(negDir[axis], intervalMin, PacketFloat::max(tr, intervalMin));
+                            PacketFloat rightMax = PacketFloat::select(negDir[axis], PacketFloat::min(tr, intervalMax), intervalMax);
+                            uint32 leftActive = (leftMin <= leftMax).bits() & active;
+                            uint32 rightActive = (rightMin <= rightMax).bits() & active;
+
+                            // rays pass between clip zones
+                            if (!leftActive && !rightActive)
+                                break;
+
+                            if (!rightActive || (leftActive && !rightFirst[axis]))
+                            {
+                                if (rightActive)
+                                {
+                                    stack[stackPos].node = offset + 3;
+                                    stack[stackPos].tnear = rightMin;
+                                    stack[stackPos].tfar = rightMax;
+                                    stackPos++;
+                                }
+                                node = offset;
+                                intervalMin = leftMin;
+                                intervalMax = leftMax;
+                            }
+                            else
+                            {
+                                if (leftActive)
+                                {
+                                    stack[stackPos].node = offset;
+                                    stack[stackPos].tnear = leftMin;
+                                    stack[stackPos].tfar = leftMax;
+                                    stackPos++;
+                                }
+                                node = offset + 3;
+                                intervalMin = rightMin;
+                                intervalMax = rightMax;
+                            }
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0) {
+                                uint32 hits = intersectCallback(packet, active, objects[offset], maxDist, stopAtFirst);
+                                if (stopAtFirst)
+                                {
+                                    finished |= hits;
+                                    active &= ~hits;
+                                    if (!active)
+                                        break;
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            if (stopAtFirst && (finished & lanes) == lanes)
+                                return;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        PacketFloat tlo = (PacketFloat(intBitsToFloat(tree[node + 1])) - packet.org[axis]) * packet.invDir[axis];
+                        PacketFloat thi = (PacketFloat(intBitsToFloat(tree[node + 2])) - packet.org[axis]) * packet.invDir[axis];
+                        node = offset;
+                        intervalMin = PacketFloat::max(PacketFloat::select(negDir[axis], thi, tlo), intervalMin);
+                        intervalMax = PacketFloat::min(PacketFloat::select(negDir[axis], tlo, thi), intervalMax);
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack, lanes that found a closer hit meanwhile may drop out
+                    stackPos--;
+                    intervalMin = stack[stackPos].tnear;
+                    intervalMax = PacketFloat::min(stack[stackPos].tfar, PacketFloat(maxDist[0], maxDist[1], maxDist[2], maxDist[3]));
+                    if (!((intervalMin <= intervalMax).bits() & lanes & ~finished))
+                        continue;
+                    node = stack[stackPos].node;
+                    break;
+                } while (true);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -357,6 +482,53 @@ class BIH
             float tfar;
         };
 
+        struct PacketStackNode
+        {
+            uint32 node;
+            PacketFloat tnear;
+            PacketFloat tfar;
+        };
+
+        static uint32 activeCount(uint32 lanes)
+        {
+            uint32 count = 0;
+            for (; lanes; lanes &= lanes - 1)
+                ++count;
+            return count;
+        }
+
+        // clip the ray against the tree bounds, false if it misses them within maxDist
+        bool clipRay(const Vector3 &org, const Vector3 &dir, float maxDist, float &intervalMin, float &intervalMax) const
+        {
+            intervalMin = -1.f;
+            intervalMax = -1.f;
+            for (int i=0; i<3; ++i)
+            {
+                if (G3D::fuzzyNe(dir[i], 0.0f))
+                {
+                    float invDir = 1.f / dir[i];
+                    float t1 = (bounds.low()[i]  - org[i]) * invDir;
+                    float t2 = (bounds.high()[i] - org[i]) * invDir;
+                    if (t1 > t2)
+                        std::swap(t1, t2);
+                    if (t1 > intervalMin)
+                        intervalMin = t1;
+                    if (t2 < intervalMax || intervalMax < 0.f)
+                        intervalMax = t2;
+                    // intervalMax can only become smaller for other axis,
+                    //  and intervalMin only larger respectively, so stop early
+                    if (intervalMax <= 0 || intervalMin >= maxDist)
+                        return false;
+                }
+            }
+
+            if (intervalMin > intervalMax)
+                return false;
+            intervalMin = std::max(intervalMin, 0.f);
+            intervalMax = std::min(intervalMax, maxDist);
+            return true;
+        }
+
         class BuildStats
         {
             private:
@@ -41,6 +41,23 @@ namespace VMAP
     #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
     #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
+    struct VMapCacheStats
+    {
+        uint64 losHits;
+        uint64 losMisses;
+        uint64 losSavedTime;                                // in microseconds, estimated from the average miss
+        uint64 heightHits;
+        uint64 heightMisses;
+        uint64 heightSavedTime;
+    };
+
+    struct LineOfSightQuery
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+        bool result;                                        // filled by isInLineOfSight
+    };
+
     //===========================================================
     class IVMapManager
     {
@@ -61,6 +78,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            answer several line of sight queries on the same map at once, faster than one call per query
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, LineOfSightQuery* pQueries, uint32 pCount) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
@@ -94,6 +115,10 @@ namespace VMAP
             */
             virtual bool getAreaInfo(unsigned int pMapId, float x, float y, float &z, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const=0;
             virtual bool GetLiquidLevel(uint32 pMapId, float x, float y, float z, uint8 ReqLiquidType, float &level, float &floor, uint32 &type) const=0;
+            /**
+            Line of sight and height query cache statistics
+            */
+            virtual void getCacheStats(VMapCacheStats& stats) const=0;
     };
 
 }
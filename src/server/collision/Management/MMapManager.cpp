@@ -19,6 +19,8 @@
 #include "MMapManager.h"
 #include "Log.h"
 #include "World.h"
+#include <ace/Mem_Map.h>
+#include <algorithm>
 
 //  memory management
 inline void* dtCustomAlloc(int size, dtAllocHint /*hint*/)
@@ -37,17 +39,25 @@ namespace MMAP
     MMapManager::~MMapManager()
     {
         for (MMapDataSet::iterator i = loadedMMaps.begin(); i != loadedMMaps.end(); ++i)
-            delete i->second;
+        {
+            MMapData* mmap = i->second;
+            for (MMapTileSet::iterator itr = mmap->mmapLoadedTiles.begin(); itr != mmap->mmapLoadedTiles.end(); ++itr)
+            {
+                // tile data is not owned by detour, it has to go before we unmap it
+                mmap->navMesh->removeTile(itr->second.tileRef, NULL, NULL);
+                delete itr->second.file;
+            }
 
-        // by now we should not have maps loaded
-        // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
+            delete mmap;
+        }
     }
 
-    bool MMapManager::loadMapData(uint32 mapId)
+    MMapData* MMapManager::loadMapData(uint32 mapId)
     {
         // we already have this map loaded?
-        if (loadedMMaps.find(mapId) != loadedMMaps.end())
-            return true;
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr != loadedMMaps.end())
+            return itr->second;
 
         // load and init dtNavMesh - read parameters from file
         uint32 pathLen = sWorld->GetDataPath().length() + strlen("mmaps/%03i.mmap")+1;
@@ -59,7 +69,7 @@ namespace MMAP
         {
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:loadMapData: Error: Could not open mmap file '%s'", fileName);
             delete [] fileName;
-            return false;
+            return NULL;
         }
 
         dtNavMeshParams params;
@@ -73,7 +83,7 @@ namespace MMAP
             dtFreeNavMesh(mesh);
             sLog->outError("MMAP:loadMapData: Failed to initialize dtNavMesh for mmap %03u from file %s", mapId, fileName);
             delete [] fileName;
-            return false;
+            return NULL;
         }
 
         delete [] fileName;
@@ -85,7 +95,7 @@ namespace MMAP
         mmap_data->mmapLoadedTiles.clear();
 
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
-        return true;
+        return mmap_data;
     }
 
     uint32 MMapManager::packTileID(int32 x, int32 y)
@@ -95,133 +105,312 @@ namespace MMAP
 
     bool MMapManager::loadMap(uint32 mapId, int32 x, int32 y)
     {
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
         // make sure the mmap is loaded and ready to load tiles
-        if(!loadMapData(mapId))
+        MMapData* mmap = loadMapData(mapId);
+        if (!mmap)
             return false;
 
-        // get this mmap data
-        MMapData* mmap = loadedMMaps[mapId];
         ASSERT(mmap->navMesh);
 
-        // check if we already have this tile loaded
+        // the tile may already have been paged in by a path search or another instance of this map
         uint32 packedGridPos = packTileID(x, y);
-        if (mmap->mmapLoadedTiles.find(packedGridPos) != mmap->mmapLoadedTiles.end())
+        MMapTileSet::iterator itr = mmap->mmapLoadedTiles.find(packedGridPos);
+        if (itr != mmap->mmapLoadedTiles.end())
         {
-            sLog->outError("MMAP:loadMap: Asked to load already loaded navmesh tile. %03u%02i%02i.mmtile", mapId, x, y);
-            return false;
+            itr->second.unloadPending = false;
+            tileLRU.splice(tileLRU.begin(), tileLRU, itr->second.lruPos);
+            return true;
         }
 
+        if (mmap->mmapMissingTiles.find(packedGridPos) != mmap->mmapMissingTiles.end())
+            return false;
+
+        if (!loadTile(mapId, mmap, x, y))
+            return false;
+
+        evictTiles(1);
+        return true;
+    }
+
+    bool MMapManager::loadTile(uint32 mapId, MMapData* mmap, int32 x, int32 y)
+    {
+        ACE_Time_Value startTime = ACE_OS::gettimeofday();
+        uint32 packedGridPos = packTileID(x, y);
+
         // load this tile :: mmaps/MMMXXYY.mmtile
         uint32 pathLen = sWorld->GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile")+1;
         char *fileName = new char[pathLen];
         snprintf(fileName, pathLen, (sWorld->GetDataPath()+"mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
 
-        FILE *file = fopen(fileName, "rb");
-        if (!file)
+        // private mapping - pages stay shared with the file cache until detour writes tile links into them
+        ACE_Mem_Map* file = new ACE_Mem_Map();
+        if (file->map(fileName, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == -1)
         {
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:loadMap: Could not open mmtile file '%s'", fileName);
+            mmap->mmapMissingTiles.insert(packedGridPos);
+            delete file;
             delete [] fileName;
             return false;
         }
         delete [] fileName;
 
+        // the mapping outlives its descriptor, don't hold one per resident tile
+        file->close_handle();
+
         // read header
-        MmapTileHeader fileHeader;
-        fread(&fileHeader, sizeof(MmapTileHeader), 1, file);
+        if (file->size() < sizeof(MmapTileHeader))
+        {
+            sLog->outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
+            mmap->mmapMissingTiles.insert(packedGridPos);
+            delete file;
+            return false;
+        }
 
-        if (fileHeader.mmapMagic != MMAP_MAGIC)
+        MmapTileHeader const* fileHeader = (MmapTileHeader const*)file->addr();
+        if (fileHeader->mmapMagic != MMAP_MAGIC)
         {
             sLog->outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
+            mmap->mmapMissingTiles.insert(packedGridPos);
+            delete file;
             return false;
         }
 
-        if (fileHeader.mmapVersion != MMAP_VERSION)
+        if (fileHeader->mmapVersion != MMAP_VERSION)
         {
             sLog->outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
-                mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
+                mapId, x, y, fileHeader->mmapVersion, MMAP_VERSION);
+            mmap->mmapMissingTiles.insert(packedGridPos);
+            delete file;
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
-
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if(!result)
+        if (file->size() < sizeof(MmapTileHeader) + fileHeader->size)
         {
             sLog->outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            mmap->mmapMissingTiles.insert(packedGridPos);
+            delete file;
             return false;
         }
 
-        fclose(file);
-
+        unsigned char* data = (unsigned char*)file->addr() + sizeof(MmapTileHeader);
+        uint32 size = fileHeader->size;
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (DT_SUCCESS == mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef))
+        // data is owned by the mapping, detour must not free it when the tile is removed
+        dtStatus result;
         {
-            mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-            ++loadedTiles;
-            sLog->outDetail("MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
-            return true;
+            TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, mmap->navMeshLock);
+            result = mmap->navMesh->addTile(data, size, 0, 0, &tileRef);
         }
-        else
+
+        if (DT_SUCCESS != result)
         {
             sLog->outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
+            mmap->mmapMissingTiles.insert(packedGridPos);
+            delete file;
+            return false;
+        }
+
+        MMapTile& tile = mmap->mmapLoadedTiles[packedGridPos];
+        tile.tileRef = tileRef;
+        tile.file = file;
+        tile.size = size;
+        tile.lruPos = tileLRU.insert(tileLRU.begin(), packTileKey(mapId, packedGridPos));
+
+        ++loadedTiles;
+        loadedBytes += size;
+        ++tileLoads;
+
+        ACE_UINT64 loadTime;
+        (ACE_OS::gettimeofday() - startTime).to_usec(loadTime);
+        totalLoadTime += loadTime;
+        if (loadTime > maxLoadTime)
+            maxLoadTime = uint32(loadTime);
+
+        sLog->outDetail("MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        return true;
+    }
+
+    bool MMapManager::unloadTile(uint32 mapId, MMapData* mmap, uint32 packedGridPos)
+    {
+        MMapTileSet::iterator itr = mmap->mmapLoadedTiles.find(packedGridPos);
+        ASSERT(itr != mmap->mmapLoadedTiles.end());
+
+        int32 x = (packedGridPos >> 16);
+        int32 y = (packedGridPos & 0x0000FFFF);
+
+        dtStatus result;
+        {
+            TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, mmap->navMeshLock);
+            result = mmap->navMesh->removeTile(itr->second.tileRef, NULL, NULL);
+        }
+
+        // unload, and mark as non loaded
+        if (DT_SUCCESS != result)
+        {
+            // tile data is still referenced by the navmesh, we cannot unmap it
+            // we cannot recover from this error - assert out
+            sLog->outError("MMAP:unloadMap: Could not unload %03u%02i%02i.mmtile from navmesh", mapId, x, y);
+            ASSERT(false);
             return false;
         }
 
-        return false;
+        delete itr->second.file;
+        tileLRU.erase(itr->second.lruPos);
+        --loadedTiles;
+        loadedBytes -= itr->second.size;
+        mmap->mmapLoadedTiles.erase(itr);
+
+        sLog->outDetail("MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
+        return true;
+    }
+
+    void MMapManager::evictTiles(uint32 keep)
+    {
+        if (!memoryBudget)
+            return;
+
+        // the first 'keep' tiles were just used by the caller, pinned tiles are in use by a path search
+        MMapTileLRU::iterator itr = tileLRU.end();
+        uint32 remaining = tileLRU.size();
+        while (loadedBytes > memoryBudget && remaining > keep)
+        {
+            --itr;
+            --remaining;
+
+            MMapTileKey key = *itr;
+            uint32 mapId = uint32(key >> 32);
+            uint32 packedGridPos = uint32(key & 0xFFFFFFFF);
+            MMapDataSet::iterator mapItr = loadedMMaps.find(mapId);
+            ASSERT(mapItr != loadedMMaps.end());
+
+            MMapData* mmap = mapItr->second;
+            if (mmap->mmapLoadedTiles[packedGridPos].pins)
+                continue;
+
+            // step past the tile, unloading it drops its LRU entry
+            ++itr;
+            if (!unloadTile(mapId, mmap, packedGridPos))
+                break;
+
+            ++tileEvictions;
+        }
+    }
+
+    void MMapManager::touchTiles(uint32 mapId, float startX, float startY, float endX, float endY, std::vector<uint32>& pinned)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        MMapData* mmap = loadMapData(mapId);
+        if (!mmap)
+            return;
+
+        // tiles are named and packed like grid maps, world Y first - see Map::LoadMMap
+        int32 minX = std::max(int32(32 - std::max(startY, endY) / MMAP_TILE_SIZE), 0);
+        int32 maxX = std::min(int32(32 - std::min(startY, endY) / MMAP_TILE_SIZE), MMAP_MAX_TILES - 1);
+        int32 minY = std::max(int32(32 - std::max(startX, endX) / MMAP_TILE_SIZE), 0);
+        int32 maxY = std::min(int32(32 - std::min(startX, endX) / MMAP_TILE_SIZE), MMAP_MAX_TILES - 1);
+
+        // the search may leave the straight line between both points, so take every tile of the box around them
+        for (int32 x = minX; x <= maxX; ++x)
+        {
+            for (int32 y = minY; y <= maxY; ++y)
+            {
+                uint32 packedGridPos = packTileID(x, y);
+                MMapTileSet::iterator itr = mmap->mmapLoadedTiles.find(packedGridPos);
+                if (itr == mmap->mmapLoadedTiles.end())
+                {
+                    if (mmap->mmapMissingTiles.find(packedGridPos) != mmap->mmapMissingTiles.end())
+                        continue;
+
+                    if (!loadTile(mapId, mmap, x, y))
+                        continue;
+
+                    itr = mmap->mmapLoadedTiles.find(packedGridPos);
+                }
+                else
+                    tileLRU.splice(tileLRU.begin(), tileLRU, itr->second.lruPos);
+
+                ++itr->second.pins;
+                pinned.push_back(packedGridPos);
+            }
+        }
+
+        evictTiles(0);
+    }
+
+    void MMapManager::releaseTiles(uint32 mapId, std::vector<uint32> const& pinned)
+    {
+        if (pinned.empty())
+            return;
+
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        // the whole map may have been unloaded meanwhile
+        MMapDataSet::iterator mapItr = loadedMMaps.find(mapId);
+        if (mapItr == loadedMMaps.end())
+            return;
+
+        MMapData* mmap = mapItr->second;
+        for (std::vector<uint32>::const_iterator i = pinned.begin(); i != pinned.end(); ++i)
+        {
+            MMapTileSet::iterator itr = mmap->mmapLoadedTiles.find(*i);
+            if (itr == mmap->mmapLoadedTiles.end())
+                continue;
+
+            // its grid went away while we were using the tile
+            if (!--itr->second.pins && itr->second.unloadPending)
+                unloadTile(mapId, mmap, *i);
+        }
+
+        // tiles loaded while others were pinned may have left us over budget
+        evictTiles(0);
     }
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
         // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMap: Asked to unload not loaded navmesh map. %03u%02i%02i.mmtile", mapId, x, y);
             return false;
         }
 
-        MMapData* mmap = loadedMMaps[mapId];
+        MMapData* mmap = itr->second;
 
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
-        if (mmap->mmapLoadedTiles.find(packedGridPos) == mmap->mmapLoadedTiles.end())
+        MMapTileSet::iterator tileItr = mmap->mmapLoadedTiles.find(packedGridPos);
+        if (tileItr == mmap->mmapLoadedTiles.end())
         {
-            // file may not exist, therefore not loaded
+            // file may not exist or the tile was already evicted, therefore not loaded
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMap: Asked to unload not loaded navmesh tile. %03u%02i%02i.mmtile", mapId, x, y);
             return false;
         }
 
-        dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
-
-        // unload, and mark as non loaded
-        if (DT_SUCCESS != mmap->navMesh->removeTile(tileRef, NULL, NULL))
-        {
-            // this is technically a memory leak
-            // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
-            // we cannot recover from this error - assert out
-            sLog->outError("MMAP:unloadMap: Could not unload %03u%02i%02i.mmtile from navmesh", mapId, x, y);
-            ASSERT(false);
-        }
-        else
+        // a path search still uses it, the last one to release it unloads it
+        if (tileItr->second.pins)
         {
-            mmap->mmapLoadedTiles.erase(packedGridPos);
-            --loadedTiles;
-            sLog->outDetail("MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
+            tileItr->second.unloadPending = true;
             return true;
         }
 
-        return false;
+        return unloadTile(mapId, mmap, packedGridPos);
     }
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMap: Asked to unload not loaded navmesh map %03u", mapId);
@@ -229,22 +418,13 @@ namespace MMAP
         }
 
         // unload all tiles from given map
-        MMapData* mmap = loadedMMaps[mapId];
-        for (MMapTileSet::iterator i = mmap->mmapLoadedTiles.begin(); i != mmap->mmapLoadedTiles.end(); ++i)
-        {
-            uint32 x = (i->first >> 16);
-            uint32 y = (i->first & 0x0000FFFF);
-            if (DT_SUCCESS != mmap->navMesh->removeTile(i->second, NULL, NULL))
-                sLog->outError("MMAP:unloadMap: Could not unload %03u%02i%02i.mmtile from navmesh", mapId, x, y);
-            else
-            {
-                --loadedTiles;
-                sLog->outDetail("MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
-            }
-        }
+        MMapData* mmap = itr->second;
+        while (!mmap->mmapLoadedTiles.empty())
+            if (!unloadTile(mapId, mmap, mmap->mmapLoadedTiles.begin()->first))
+                break;
 
         delete mmap;
-        loadedMMaps.erase(mapId);
+        loadedMMaps.erase(itr);
         sLog->outDetail("MMAP:unloadMap: Unloaded %03i.mmap", mapId);
 
         return true;
@@ -252,25 +432,27 @@ namespace MMAP
 
     bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
     {
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
         // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
             return false;
         }
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        MMapData* mmap = itr->second;
+        NavMeshQuerySet::iterator queryItr = mmap->navMeshQueries.find(instanceId);
+        if (queryItr == mmap->navMeshQueries.end())
         {
             sLog->outDebug(LOG_FILTER_MAPS, "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
             return false;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
+        dtFreeNavMeshQuery(queryItr->second);
+        mmap->navMeshQueries.erase(queryItr);
         sLog->outDetail("MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
 
         return true;
@@ -278,34 +460,65 @@ namespace MMAP
 
     dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        // navmesh parameters are loaded with the first query, tiles follow with touchTiles
+        MMapData* mmap = loadMapData(mapId);
+        if (!mmap)
+            return NULL;
+
+        return mmap->navMesh;
+    }
+
+    ACE_RW_Thread_Mutex* MMapManager::GetNavMeshLock(uint32 mapId)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
             return NULL;
 
-        return loadedMMaps[mapId]->navMesh;
+        return &itr->second->navMeshLock;
     }
 
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        MMapData* mmap = loadMapData(mapId);
+        if (!mmap)
             return NULL;
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if (DT_SUCCESS != query->init(mmap->navMesh, 1024))
-            {
-                dtFreeNavMeshQuery(query);
-                sLog->outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return NULL;
-            }
+        NavMeshQuerySet::const_iterator itr = mmap->navMeshQueries.find(instanceId);
+        if (itr != mmap->navMeshQueries.end())
+            return itr->second;
 
-            sLog->outDetail("MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (DT_SUCCESS != query->init(mmap->navMesh, 1024))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog->outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+            return NULL;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        sLog->outDetail("MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+        mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+        return query;
     }
-}
\ No newline at end of file
+
+    void MMapManager::getStats(MMapStats& stats)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+        stats.loadedMaps = loadedMMaps.size();
+        stats.loadedTiles = loadedTiles;
+        stats.loadedBytes = loadedBytes;
+        stats.memoryBudget = memoryBudget;
+        stats.tileLoads = tileLoads;
+        stats.tileEvictions = tileEvictions;
+        stats.totalLoadTime = totalLoadTime;
+        stats.maxLoadTime = maxLoadTime;
+    }
+}
@@ -16,15 +16,45 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifndef _MMAP_MANAGER_H
+#define _MMAP_MANAGER_H
+
 #include "UnorderedMap.h"
 #include "DetourAlloc.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Thread_Mutex.h>
+#include <list>
+#include <set>
+#include <vector>
+
+class ACE_Mem_Map;
+
+#define MMAP_TILE_SIZE      533.33333f
+#define MMAP_MAX_TILES      64
 
 //  move map related classes
 namespace MMAP
 {
-    typedef UNORDERED_MAP<uint32, dtTileRef> MMapTileSet;
+    // [mapId][packed tile coords], identifies a tile across all loaded mmaps
+    typedef uint64 MMapTileKey;
+    typedef std::list<MMapTileKey> MMapTileLRU;
+
+    // navmesh tile paged in from its .mmtile file
+    struct MMapTile
+    {
+        MMapTile() : tileRef(0), file(NULL), size(0), pins(0), unloadPending(false) {}
+
+        dtTileRef tileRef;
+        ACE_Mem_Map* file;                  // private (copy-on-write) mapping of the file, detour writes links into it
+        uint32 size;                        // size of the navmesh data, without MmapTileHeader
+        MMapTileLRU::iterator lruPos;       // our position in MMapManager's LRU list
+        uint32 pins;                        // path searches using the tile, it is not evicted while pinned
+        bool unloadPending;                 // grid was unloaded while the tile was pinned, unload on last release
+    };
+
+    typedef UNORDERED_MAP<uint32, MMapTile> MMapTileSet;
     typedef UNORDERED_MAP<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
@@ -44,18 +74,36 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
-        MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
-    };
+        MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [tile]
+        std::set<uint32> mmapMissingTiles;  // [map grid coords] without .mmtile file, not looked up again
 
+        // navMesh is shared by all instances of the map, which may be updated by different map threads
+        // queries hold it for reading, adding and evicting tiles holds it for writing
+        ACE_RW_Thread_Mutex navMeshLock;
+    };
 
     typedef UNORDERED_MAP<uint32, MMapData*> MMapDataSet;
 
+    struct MMapStats
+    {
+        uint32 loadedMaps;
+        uint32 loadedTiles;
+        uint64 loadedBytes;
+        uint64 memoryBudget;                // 0 - unlimited
+        uint32 tileLoads;                   // including reloads of evicted tiles
+        uint32 tileEvictions;
+        uint64 totalLoadTime;               // in microseconds
+        uint32 maxLoadTime;                 // in microseconds
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
+    // tiles are paged in on first use and evicted in LRU order once over the memory budget
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), loadedBytes(0), memoryBudget(0), tileLoads(0), tileEvictions(0),
+                totalLoadTime(0), maxLoadTime(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
@@ -63,17 +111,61 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
+            // makes sure every tile in the box spanned by the two world positions is loaded, marks them as recently used
+            // and pins them, pinned tiles are stored in 'pinned' and must be given back with releaseTiles
+            void touchTiles(uint32 mapId, float startX, float startY, float endX, float endY, std::vector<uint32>& pinned);
+            void releaseTiles(uint32 mapId, std::vector<uint32> const& pinned);
+
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
+            // hold GetNavMeshLock for reading while using either of them, and keep the used tiles pinned
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            ACE_RW_Thread_Mutex* GetNavMeshLock(uint32 mapId);
+
+            // in bytes, 0 disables eviction
+            void setMemoryBudget(uint64 budget) { memoryBudget = budget; }
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+            void getStats(MMapStats& stats);
         private:
-            bool loadMapData(uint32 mapId);
+            MMapData* loadMapData(uint32 mapId);
+            bool loadTile(uint32 mapId, MMapData* mmap, int32 x, int32 y);
+            bool unloadTile(uint32 mapId, MMapData* mmap, uint32 packedGridPos);
+            void evictTiles(uint32 keep);
             uint32 packTileID(int32 x, int32 y);
+            MMapTileKey packTileKey(uint32 mapId, uint32 packedGridPos) const { return (uint64(mapId) << 32) | packedGridPos; }
 
             MMapDataSet loadedMMaps;
+            MMapTileLRU tileLRU;                // most recently used tiles first
+            ACE_Thread_Mutex lock;              // loadedMMaps, tileLRU and counters
+
             uint32 loadedTiles;
+            uint64 loadedBytes;
+            uint64 memoryBudget;
+            uint32 tileLoads;
+            uint32 tileEvictions;
+            uint64 totalLoadTime;
+            uint32 maxLoadTime;
+    };
+
+    // pins the tiles of a path search for as long as it is in scope
+    class MMapTileHolder
+    {
+        public:
+            MMapTileHolder(MMapManager* manager, uint32 mapId, float startX, float startY, float endX, float endY)
+                : _manager(manager), _mapId(mapId)
+            {
+                _manager->touchTiles(_mapId, startX, startY, endX, endY, _pinned);
+            }
+
+            ~MMapTileHolder() { _manager->releaseTiles(_mapId, _pinned); }
+
+        private:
+            MMapManager* _manager;
+            uint32 _mapId;
+            std::vector<uint32> _pinned;
     };
-}
\ No newline at end of file
+}
+
+#endif
@@ -29,13 +29,15 @@
 #include <G3D/Vector3.h>
 #include <ace/Null_Mutex.h>
 #include <ace/Singleton.h>
+#include <ace/OS_NS_sys_time.h>
 #include "DisableMgr.h"
 
 using G3D::Vector3;
 
 namespace VMAP
 {
-    VMapManager2::VMapManager2()
+    VMapManager2::VMapManager2() : iLosCacheHits(0), iLosCacheMisses(0), iLosMissTime(0),
+        iHeightCacheHits(0), iHeightCacheMisses(0), iHeightMissTime(0)
     {
     }
 
@@ -142,13 +144,92 @@ namespace VMAP
             Vector3 pos2 = convertPositionToInternalRep(x2, y2, z2);
             if (pos1 != pos2)
             {
-                return instanceTree->second->isInLineOfSight(pos1, pos2);
+                StaticMapTree* tree = instanceTree->second;
+                QueryCache& cache = tree->getQueryCache();
+                uint32 generation = cache.getGeneration();
+                uint64 key = QueryCache::makeLineOfSightKey(pos1, pos2);
+
+                bool result;
+                if (cache.findLineOfSight(key, generation, result))
+                {
+                    ++iLosCacheHits;
+                    return result;
+                }
+
+                ACE_Time_Value startTime = ACE_OS::gettimeofday();
+                result = tree->isInLineOfSight(pos1, pos2);
+                cache.storeLineOfSight(key, generation, result);
+
+                ACE_UINT64 missTime;
+                (ACE_OS::gettimeofday() - startTime).to_usec(missTime);
+                ++iLosCacheMisses;
+                iLosMissTime += long(missTime);
+                return result;
             }
         }
 
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, LineOfSightQuery* queries, uint32 count)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            queries[i].result = true;
+
+        if (!count || !isLineOfSightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS))
+            return;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        StaticMapTree* tree = instanceTree->second;
+        QueryCache& cache = tree->getQueryCache();
+        uint32 generation = cache.getGeneration();
+
+        // answer what we can from the cache and trace the rest as one batch
+        std::vector<Vector3> from, to;
+        std::vector<uint64> keys;
+        std::vector<uint32> missed;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 pos1 = convertPositionToInternalRep(queries[i].x1, queries[i].y1, queries[i].z1);
+            Vector3 pos2 = convertPositionToInternalRep(queries[i].x2, queries[i].y2, queries[i].z2);
+            if (pos1 == pos2)
+                continue;
+
+            uint64 key = QueryCache::makeLineOfSightKey(pos1, pos2);
+            if (cache.findLineOfSight(key, generation, queries[i].result))
+            {
+                ++iLosCacheHits;
+                continue;
+            }
+
+            from.push_back(pos1);
+            to.push_back(pos2);
+            keys.push_back(key);
+            missed.push_back(i);
+        }
+
+        if (missed.empty())
+            return;
+
+        ACE_Time_Value startTime = ACE_OS::gettimeofday();
+        bool* results = new bool[missed.size()];
+        tree->isInLineOfSight(&from[0], &to[0], results, missed.size());
+        for (uint32 i = 0; i < missed.size(); ++i)
+        {
+            queries[missed[i]].result = results[i];
+            cache.storeLineOfSight(keys[i], generation, results[i]);
+        }
+        delete[] results;
+
+        ACE_UINT64 missTime;
+        (ACE_OS::gettimeofday() - startTime).to_usec(missTime);
+        iLosCacheMisses += long(missed.size());
+        iLosMissTime += long(missTime);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -191,7 +272,26 @@ namespace VMAP
             if (instanceTree != iInstanceMapTrees.end())
             {
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                float height = instanceTree->second->getHeight(pos, maxSearchDist);
+                StaticMapTree* tree = instanceTree->second;
+                QueryCache& cache = tree->getQueryCache();
+                uint32 generation = cache.getGeneration();
+                uint64 key = QueryCache::makeHeightKey(pos, maxSearchDist);
+
+                float height;
+                if (cache.findHeight(key, generation, height))
+                    ++iHeightCacheHits;
+                else
+                {
+                    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+                    height = tree->getHeight(pos, maxSearchDist);
+                    cache.storeHeight(key, generation, height);
+
+                    ACE_UINT64 missTime;
+                    (ACE_OS::gettimeofday() - startTime).to_usec(missTime);
+                    ++iHeightCacheMisses;
+                    iHeightMissTime += long(missTime);
+                }
+
                 if (!(height < G3D::inf()))
                     return height = VMAP_INVALID_HEIGHT_VALUE; // No height
 
@@ -245,6 +345,16 @@ namespace VMAP
         return false;
     }
 
+    void VMapManager2::getCacheStats(VMapCacheStats& stats) const
+    {
+        stats.losHits = iLosCacheHits.value();
+        stats.losMisses = iLosCacheMisses.value();
+        stats.losSavedTime = stats.losMisses ? stats.losHits * iLosMissTime.value() / stats.losMisses : 0;
+        stats.heightHits = iHeightCacheHits.value();
+        stats.heightMisses = iHeightCacheMisses.value();
+        stats.heightSavedTime = stats.heightMisses ? stats.heightHits * iHeightMissTime.value() / stats.heightMisses : 0;
+    }
+
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename)
     {
         //! Critical section, thread safe access to iLoadedModelFiles
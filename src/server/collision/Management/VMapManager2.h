@@ -23,6 +23,7 @@
 #include "Dynamic/UnorderedMap.h"
 #include "Define.h"
 #include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 
 //===========================================================
 
@@ -74,6 +75,13 @@ namespace VMAP
             InstanceTreeMap iInstanceMapTrees;
             // Mutex for iLoadedModelFiles
             ACE_Thread_Mutex LoadedModelFilesLock;
+            // query cache statistics, time spent on misses in microseconds
+            ACE_Atomic_Op<ACE_Thread_Mutex, long> iLosCacheHits;
+            ACE_Atomic_Op<ACE_Thread_Mutex, long> iLosCacheMisses;
+            ACE_Atomic_Op<ACE_Thread_Mutex, long> iLosMissTime;
+            ACE_Atomic_Op<ACE_Thread_Mutex, long> iHeightCacheHits;
+            ACE_Atomic_Op<ACE_Thread_Mutex, long> iHeightCacheMisses;
+            ACE_Atomic_Op<ACE_Thread_Mutex, long> iHeightMissTime;
 
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
             /* void _unloadMap(uint32 pMapId, uint32 x, uint32 y); */
@@ -92,6 +100,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId);
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) ;
+            void isInLineOfSight(unsigned int mapId, LineOfSightQuery* queries, uint32 count);
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -102,6 +111,7 @@ namespace VMAP
 
             bool getAreaInfo(unsigned int pMapId, float x, float y, float& z, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const;
             bool GetLiquidLevel(uint32 pMapId, float x, float y, float z, uint8 reqLiquidType, float& level, float& floor, uint32& type) const;
+            void getCacheStats(VMapCacheStats& stats) const;
 
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename);
             void releaseModelInstance(const std::string& filename);
@@ -55,6 +55,22 @@ namespace VMAP
         bool hit;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val): prims(val), hits(0) {}
+            uint32 operator()(const RayPacket& packet, uint32 lanes, uint32 entry, float* distance, bool pStopAtFirstHit=true)
+            {
+                uint32 result = prims[entry].intersectRayPacket(packet, lanes, distance, pStopAtFirstHit);
+                hits |= result;
+                return result;
+            }
+        uint32 didHit() { return hits; }
+    protected:
+        ModelInstance* prims;
+        uint32 hits;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -172,6 +188,53 @@ namespace VMAP
 
         return true;
     }
+
+    uint32 StaticMapTree::getIntersectionPacket(const G3D::Ray* pRays, uint32 pLanes, float* pMaxDist) const
+    {
+        RayPacket packet(pRays, pLanes);
+        MapRayPacketCallback intersectionCallBack(iTreeValues);
+        iTree.intersectRayPacket(packet, pLanes, intersectionCallBack, pMaxDist, true);
+        return intersectionCallBack.didHit();
+    }
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, bool* results, uint32 count) const
+    {
+        G3D::Ray rays[RAY_PACKET_SIZE];
+        float maxDist[RAY_PACKET_SIZE];
+        uint32 index[RAY_PACKET_SIZE];
+        uint32 laneCount = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            results[i] = true;
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too
+            ASSERT(dist < std::numeric_limits<float>::max());
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (dist < 1e-10f)
+                continue;
+
+            rays[laneCount] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i])/dist);
+            maxDist[laneCount] = dist;
+            index[laneCount] = i;
+            if (++laneCount < RAY_PACKET_SIZE)
+                continue;
+
+            uint32 hits = getIntersectionPacket(rays, (1 << laneCount) - 1, maxDist);
+            for (uint32 lane = 0; lane < laneCount; ++lane)
+                if (hits & (1 << lane))
+                    results[index[lane]] = false;
+            laneCount = 0;
+        }
+
+        if (laneCount)
+        {
+            uint32 hits = getIntersectionPacket(rays, (1 << laneCount) - 1, maxDist);
+            for (uint32 lane = 0; lane < laneCount; ++lane)
+                if (hits & (1 << lane))
+                    results[index[lane]] = false;
+        }
+    }
+
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -341,6 +404,7 @@ namespace VMAP
         }
         iLoadedSpawns.clear();
         iLoadedTiles.clear();
+        iQueryCache.invalidate();
     }
 
     //=========================================================
@@ -418,6 +482,7 @@ namespace VMAP
             }
             iLoadedTiles[packTileID(tileX, tileY)] = true;
             fclose(tf);
+            iQueryCache.invalidate();
         }
         else
             iLoadedTiles[packTileID(tileX, tileY)] = false;
@@ -476,6 +541,7 @@ namespace VMAP
                     }
                 }
                 fclose(tf);
+                iQueryCache.invalidate();
             }
         }
         iLoadedTiles.erase(tile);
@@ -22,6 +22,7 @@
 #include "Define.h"
 #include "Dynamic/UnorderedMap.h"
 #include "BoundingIntervalHierarchy.h"
+#include "QueryCache.h"
 
 namespace VMAP
 {
@@ -55,9 +56,12 @@ namespace VMAP
             // stores <tree_index, reference_count> to invalidate tree values, unload map, and to be able to report errors
             loadedSpawnMap iLoadedSpawns;
             std::string iBasePath;
+            // results of recent queries, dropped whenever the tree contents change
+            QueryCache iQueryCache;
 
         private:
             bool getIntersectionTime(const G3D::Ray& pRay, float &pMaxDist, bool pStopAtFirstHit) const;
+            uint32 getIntersectionPacket(const G3D::Ray* pRays, uint32 pLanes, float* pMaxDist) const;
             //bool containsLoadedMapTile(unsigned int pTileIdent) const { return(iLoadedMapTiles.containsKey(pTileIdent)); }
         public:
             static std::string getTileFileName(uint32 mapID, uint32 tileX, uint32 tileY);
@@ -69,6 +73,8 @@ namespace VMAP
             ~StaticMapTree();
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
+            //! batched variant, rays are traced RAY_PACKET_SIZE at a time
+            void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, bool* results, uint32 count) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
@@ -81,6 +87,7 @@ namespace VMAP
             bool isTiled() const { return iIsTiled; }
             uint32 numLoadedTiles() const { return iLoadedTiles.size(); }
             void getModelInstances(ModelInstance* &models, uint32 &count);
+            QueryCache& getQueryCache() { return iQueryCache; }
     };
 
     struct AreaInfo
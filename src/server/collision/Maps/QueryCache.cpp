@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "QueryCache.h"
+#include "Common.h"
+
+#include <cmath>
+
+using G3D::Vector3;
+
+namespace VMAP
+{
+    inline uint64 hashValue(uint64 hash, int32 value)
+    {
+        // FNV-1a over the quantized coordinates
+        hash ^= uint32(value);
+        return hash * UI64LIT(0x100000001B3);
+    }
+
+    inline uint64 hashPosition(uint64 hash, const Vector3& pos)
+    {
+        hash = hashValue(hash, int32(floor(pos.x / VMAP_CACHE_POS_QUANTUM)));
+        hash = hashValue(hash, int32(floor(pos.y / VMAP_CACHE_POS_QUANTUM)));
+        return hashValue(hash, int32(floor(pos.z / VMAP_CACHE_POS_QUANTUM)));
+    }
+
+    inline uint64 finalizeHash(uint64 hash)
+    {
+        // spread the bits, the low ones select the entry
+        hash ^= hash >> 33;
+        hash *= UI64LIT(0xFF51AFD7ED558CCD);
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    uint64 QueryCache::makeLineOfSightKey(const Vector3& pos1, const Vector3& pos2)
+    {
+        uint64 hash = UI64LIT(0xCBF29CE484222325);
+        hash = hashPosition(hash, pos1);
+        hash = hashPosition(hash, pos2);
+        return finalizeHash(hash);
+    }
+
+    uint64 QueryCache::makeHeightKey(const Vector3& pos, float maxSearchDist)
+    {
+        uint64 hash = UI64LIT(0xCBF29CE484222325);
+        hash = hashPosition(hash, pos);
+        hash = hashValue(hash, int32(floor(maxSearchDist / VMAP_CACHE_DIST_QUANTUM)));
+        return finalizeHash(hash);
+    }
+
+    bool QueryCache::find(const Entry& entry, uint64 key, uint32 generation, uint32& value)
+    {
+        if (entry.key != key)
+            return false;
+
+        uint64 data = entry.data;
+        if (uint32(data) != makeCheck(key, generation))
+            return false;
+
+        value = uint32(data >> 32);
+        return true;
+    }
+
+    void QueryCache::store(Entry& entry, uint64 key, uint32 generation, uint32 value)
+    {
+        // a reader seeing the new data with the old key (or the other way around) fails the check
+        entry.data = (uint64(value) << 32) | makeCheck(key, generation);
+        entry.key = key;
+    }
+
+    bool QueryCache::findLineOfSight(uint64 key, uint32 generation, bool& result) const
+    {
+        uint32 value;
+        if (!find(iLineOfSight[key & (VMAP_CACHE_LOS_SIZE - 1)], key, generation, value))
+            return false;
+
+        result = value != 0;
+        return true;
+    }
+
+    void QueryCache::storeLineOfSight(uint64 key, uint32 generation, bool result)
+    {
+        store(iLineOfSight[key & (VMAP_CACHE_LOS_SIZE - 1)], key, generation, result ? 1 : 0);
+    }
+
+    bool QueryCache::findHeight(uint64 key, uint32 generation, float& height) const
+    {
+        union { uint32 u; float f; } value;
+        if (!find(iHeight[key & (VMAP_CACHE_HEIGHT_SIZE - 1)], key, generation, value.u))
+            return false;
+
+        height = value.f;
+        return true;
+    }
+
+    void QueryCache::storeHeight(uint64 key, uint32 generation, float height)
+    {
+        union { uint32 u; float f; } value;
+        value.f = height;
+        store(iHeight[key & (VMAP_CACHE_HEIGHT_SIZE - 1)], key, generation, value.u);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2010 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _QUERYCACHE_H
+#define _QUERYCACHE_H
+
+#include "Define.h"
+#include <G3D/Vector3.h>
+
+#define VMAP_CACHE_LOS_SIZE         4096                    // entries, power of 2
+#define VMAP_CACHE_HEIGHT_SIZE      4096                    // entries, power of 2
+#define VMAP_CACHE_POS_QUANTUM      0.25f                   // positions closer than that share an entry
+#define VMAP_CACHE_DIST_QUANTUM     1.0f                    // same for the search distance of height queries
+
+namespace VMAP
+{
+    /**
+    Fixed size, direct mapped cache of StaticMapTree line of sight and height results, keyed by quantized positions.
+    Entries are read and written by all map threads without locking, a torn entry does not pass its check word and counts as a miss.
+    Loading or unloading a tile bumps the generation, which invalidates all entries at once.
+    */
+    class QueryCache
+    {
+        private:
+            struct Entry
+            {
+                Entry() : key(0), data(0) {}
+                volatile uint64 key;
+                volatile uint64 data;                       // result in high part, key and generation check in low part
+            };
+
+        public:
+            QueryCache() : iGeneration(1) {}
+
+            // read the generation before doing the query and store its result with it
+            uint32 getGeneration() const { return iGeneration; }
+            void invalidate() { ++iGeneration; }
+
+            static uint64 makeLineOfSightKey(const G3D::Vector3& pos1, const G3D::Vector3& pos2);
+            static uint64 makeHeightKey(const G3D::Vector3& pos, float maxSearchDist);
+
+            bool findLineOfSight(uint64 key, uint32 generation, bool& result) const;
+            void storeLineOfSight(uint64 key, uint32 generation, bool result);
+            bool findHeight(uint64 key, uint32 generation, float& height) const;
+            void storeHeight(uint64 key, uint32 generation, float height);
+
+        private:
+            static bool find(const Entry& entry, uint64 key, uint32 generation, uint32& value);
+            static void store(Entry& entry, uint64 key, uint32 generation, uint32 value);
+            static uint32 makeCheck(uint64 key, uint32 generation) { return uint32(key ^ (key >> 32)) ^ generation; }
+
+            Entry iLineOfSight[VMAP_CACHE_LOS_SIZE];
+            Entry iHeight[VMAP_CACHE_HEIGHT_SIZE];
+            volatile uint32 iGeneration;
+    };
+}                                                           // VMAP
+
+#endif // _QUERYCACHE_H
@@ -27,6 +27,9 @@
 #include <sstream>
 #include <iomanip>
 
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+
 using G3D::Vector3;
 using G3D::AABox;
 using G3D::inf;
@@ -54,9 +57,10 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 pThreads)
     {
         iCurrentUniqueNameId = 0;
+        iThreads = pThreads ? pThreads : 1;
         iFilterMethod = NULL;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
@@ -180,16 +184,8 @@ namespace VMAP
 
         // export objects
         std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
-        {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
-        }
+        if (!convertRawFiles(spawnedModelFiles))
+            success = false;
 
         //cleanup:
         for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
@@ -199,6 +195,62 @@ namespace VMAP
         return success;
     }
 
+    class ModelConverterThreads : public ACE_Task_Base
+    {
+        public:
+            ModelConverterThreads(TileAssembler* assembler, const std::set<std::string>& models) :
+                iAssembler(assembler), iNext(models.begin()), iEnd(models.end()), iSuccess(true) {}
+
+            int svc()
+            {
+                std::string model;
+                while (next(model))
+                {
+                    if (!iAssembler->convertRawFile(model))
+                    {
+                        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iLock, 0);
+                        std::cout << "error converting " << model << std::endl;
+                        iSuccess = false;
+                    }
+                }
+                return 0;
+            }
+
+            bool succeeded() const { return iSuccess; }
+
+        private:
+            bool next(std::string& model)
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iLock, false);
+                // stop handing out work after the first error, like the single threaded loop did
+                if (!iSuccess || iNext == iEnd)
+                    return false;
+
+                model = *iNext++;
+                std::cout << "Converting " << model << std::endl;
+                return true;
+            }
+
+            TileAssembler* iAssembler;
+            std::set<std::string>::const_iterator iNext;
+            std::set<std::string>::const_iterator iEnd;
+            bool iSuccess;
+            ACE_Thread_Mutex iLock;
+    };
+
+    bool TileAssembler::convertRawFiles(const std::set<std::string>& pModelFilenames)
+    {
+        ModelConverterThreads converters(this, pModelFilenames);
+        uint32 threads = std::min<uint32>(iThreads, pModelFilenames.size());
+        if (threads > 1 && converters.activate(THR_NEW_LWP | THR_JOINABLE, threads) != -1)
+            converters.wait();
+        else
+            converters.svc();
+
+        return converters.succeeded();
+    }
+
+    //=================================================================
     bool TileAssembler::readMapSpawns()
     {
         std::string fname = iSrcDir + "/dir_bin";
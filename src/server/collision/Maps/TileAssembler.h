@@ -22,6 +22,7 @@
 #include <G3D/Vector3.h>
 #include <G3D/Matrix3.h>
 #include <map>
+#include <set>
 
 #include "ModelInstance.h"
 
@@ -70,12 +71,15 @@ namespace VMAP
             G3D::Table<std::string, unsigned int > iUniqueNameIds;
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
+            uint32 iThreads;
 
         public:
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 pThreads = 1);
             virtual ~TileAssembler();
 
             bool convertWorld2();
+            //! converts the model files on iThreads threads, each model has its own output file
+            bool convertRawFiles(const std::set<std::string>& pModelFilenames);
             bool readMapSpawns();
             bool calculateTransformedBound(ModelSpawn &spawn);
 
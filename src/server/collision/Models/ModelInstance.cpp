@@ -65,6 +65,41 @@ namespace VMAP
         return hit;
     }
 
+    uint32 ModelInstance::intersectRayPacket(const RayPacket& pPacket, uint32 pLanes, float* pMaxDist, bool pStopAtFirstHit) const
+    {
+        if (!iModel)
+            return 0;
+
+        // same as intersectRay, lanes that miss the bound are dropped before descending into the model
+        Ray modRays[RAY_PACKET_SIZE];
+        float distance[RAY_PACKET_SIZE];
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            if (!(pLanes & (1 << i)))
+                continue;
+
+            const Ray& ray = pPacket.rays[i];
+            if (ray.intersectionTime(iBound) == G3D::inf())
+            {
+                pLanes &= ~(1 << i);
+                continue;
+            }
+
+            modRays[i] = Ray(iInvRot * (ray.origin() - iPos) * iInvScale, iInvRot * ray.direction());
+            distance[i] = pMaxDist[i] * iInvScale;
+        }
+
+        if (!pLanes)
+            return 0;
+
+        RayPacket modPacket(modRays, pLanes);
+        uint32 hits = iModel->IntersectRayPacket(modPacket, pLanes, distance, pStopAtFirstHit);
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+            if (hits & (1 << i))
+                pMaxDist[i] = distance[i] * iScale;
+        return hits;
+    }
+
     void ModelInstance::intersectPoint(const G3D::Vector3& p, AreaInfo &info) const
     {
         if (!iModel)
@@ -80,6 +80,55 @@ namespace VMAP
         return false;
     }
 
+    // IntersectTriangle for up to four rays at once, returns the lanes with a new closest hit
+    uint32 IntersectTrianglePacket(const MeshTriangle &tri, std::vector<Vector3>::const_iterator points, const RayPacket &packet, uint32 lanes, float* distance)
+    {
+        const PacketFloat EPS(1e-5f);
+        const PacketFloat zero(0.0f);
+        const PacketFloat one(1.0f);
+
+        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
+        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
+        const PacketFloat e1x(e1.x), e1y(e1.y), e1z(e1.z);
+        const PacketFloat e2x(e2.x), e2y(e2.y), e2z(e2.z);
+        const PacketFloat* dir = packet.dir;
+
+        // p = dir x e2
+        const PacketFloat px = dir[1] * e2z - dir[2] * e2y;
+        const PacketFloat py = dir[2] * e2x - dir[0] * e2z;
+        const PacketFloat pz = dir[0] * e2y - dir[1] * e2x;
+        const PacketFloat a = e1x * px + e1y * py + e1z * pz;
+        // comparisons are written as rejections so NaN lanes behave like the scalar test
+        PacketMask reject = PacketFloat::max(a, zero - a) < EPS;
+
+        const PacketFloat f = one / a;
+        const PacketFloat sx = packet.org[0] - PacketFloat(points[tri.idx0].x);
+        const PacketFloat sy = packet.org[1] - PacketFloat(points[tri.idx0].y);
+        const PacketFloat sz = packet.org[2] - PacketFloat(points[tri.idx0].z);
+        const PacketFloat u = f * (sx * px + sy * py + sz * pz);
+        reject = reject | (u < zero) | (u > one);
+
+        // q = s x e1
+        const PacketFloat qx = sy * e1z - sz * e1y;
+        const PacketFloat qy = sz * e1x - sx * e1z;
+        const PacketFloat qz = sx * e1y - sy * e1x;
+        const PacketFloat v = f * (dir[0] * qx + dir[1] * qy + dir[2] * qz);
+        reject = reject | (v < zero) | ((u + v) > one);
+
+        const PacketFloat t = f * (e2x * qx + e2y * qy + e2z * qz);
+        const PacketMask closer = (t > zero) & (t < PacketFloat(distance[0], distance[1], distance[2], distance[3]));
+        uint32 hits = closer.bits() & ~reject.bits() & lanes;
+        if (hits)
+        {
+            float tLanes[RAY_PACKET_SIZE];
+            t.store(tLanes);
+            for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+                if (hits & (1 << i))
+                    distance[i] = tLanes[i];
+        }
+        return hits;
+    }
+
     class TriBoundFunc
     {
         public:
@@ -368,6 +417,30 @@ namespace VMAP
         return callback.hit;
     }
 
+    struct GModelRayPacketCallback
+    {
+        GModelRayPacketCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
+            vertices(vert.begin()), triangles(tris.begin()), hits(0) {}
+        uint32 operator()(const RayPacket& packet, uint32 lanes, uint32 entry, float* distance, bool /*pStopAtFirstHit*/)
+        {
+            hits |= IntersectTrianglePacket(triangles[entry], vertices, packet, lanes, distance);
+            return hits;
+        }
+        std::vector<Vector3>::const_iterator vertices;
+        std::vector<MeshTriangle>::const_iterator triangles;
+        uint32 hits;
+    };
+
+    uint32 GroupModel::IntersectRayPacket(const RayPacket &packet, uint32 lanes, float* distance, bool stopAtFirstHit) const
+    {
+        if (triangles.empty())
+            return 0;
+
+        GModelRayPacketCallback callback(triangles, vertices);
+        meshTree.intersectRayPacket(packet, lanes, callback, distance, stopAtFirstHit);
+        return callback.hits;
+    }
+
     bool GroupModel::IsInsideObject(const Vector3 &pos, const Vector3 &down, float &z_dist) const
     {
         if (triangles.empty() || !iBound.contains(pos))
@@ -430,6 +503,29 @@ namespace VMAP
         return isc.hit;
     }
 
+    struct WModelRayPacketCallBack
+    {
+        WModelRayPacketCallBack(const std::vector<GroupModel> &mod): models(mod.begin()), hits(0) {}
+        uint32 operator()(const RayPacket& packet, uint32 lanes, uint32 entry, float* distance, bool pStopAtFirstHit)
+        {
+            hits |= models[entry].IntersectRayPacket(packet, lanes, distance, pStopAtFirstHit);
+            return hits;
+        }
+        std::vector<GroupModel>::const_iterator models;
+        uint32 hits;
+    };
+
+    uint32 WorldModel::IntersectRayPacket(const RayPacket &packet, uint32 lanes, float* distance, bool stopAtFirstHit) const
+    {
+        // same single submodel shortcut as IntersectRay
+        if (groupModels.size() == 1)
+            return groupModels[0].IntersectRayPacket(packet, lanes, distance, stopAtFirstHit);
+
+        WModelRayPacketCallBack isc(groupModels);
+        groupTree.intersectRayPacket(packet, lanes, isc, distance, stopAtFirstHit);
+        return isc.hits;
+    }
+
     class WModelAreaCallback {
         public:
             WModelAreaCallback(const std::vector<GroupModel> &vals, const Vector3 &down):
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _RAYPACKET_H
+#define _RAYPACKET_H
+
+#include "G3D/Vector3.h"
+#include "G3D/Ray.h"
+
+#include "Define.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define RAY_PACKET_SSE
+    #include <xmmintrin.h>
+#endif
+
+#define RAY_PACKET_SIZE 4
+
+/** Four float lanes, one per ray of a RayPacket. Uses SSE when the compiler targets it.
+    min/max return the second operand if either is NaN, like minps/maxps. */
+#ifdef RAY_PACKET_SSE
+struct PacketMask
+{
+    PacketMask(__m128 mask) : m(mask) {}
+    uint32 bits() const { return uint32(_mm_movemask_ps(m)); }
+    PacketMask operator|(const PacketMask& o) const { return _mm_or_ps(m, o.m); }
+    PacketMask operator&(const PacketMask& o) const { return _mm_and_ps(m, o.m); }
+
+    __m128 m;
+};
+
+struct PacketFloat
+{
+    PacketFloat() {}
+    PacketFloat(__m128 val) : v(val) {}
+    explicit PacketFloat(float f) : v(_mm_set1_ps(f)) {}
+    PacketFloat(float f0, float f1, float f2, float f3) : v(_mm_setr_ps(f0, f1, f2, f3)) {}
+
+    float operator[](uint32 lane) const { float f[RAY_PACKET_SIZE]; _mm_storeu_ps(f, v); return f[lane]; }
+    void store(float* f) const { _mm_storeu_ps(f, v); }
+
+    PacketFloat operator+(const PacketFloat& o) const { return _mm_add_ps(v, o.v); }
+    PacketFloat operator-(const PacketFloat& o) const { return _mm_sub_ps(v, o.v); }
+    PacketFloat operator*(const PacketFloat& o) const { return _mm_mul_ps(v, o.v); }
+    PacketFloat operator/(const PacketFloat& o) const { return _mm_div_ps(v, o.v); }
+    PacketMask operator<(const PacketFloat& o) const { return _mm_cmplt_ps(v, o.v); }
+    PacketMask operator<=(const PacketFloat& o) const { return _mm_cmple_ps(v, o.v); }
+    PacketMask operator>(const PacketFloat& o) const { return _mm_cmpgt_ps(v, o.v); }
+
+    static PacketFloat min(const PacketFloat& a, const PacketFloat& b) { return _mm_min_ps(a.v, b.v); }
+    static PacketFloat max(const PacketFloat& a, const PacketFloat& b) { return _mm_max_ps(a.v, b.v); }
+    // mask ? a : b, per lane
+    static PacketFloat select(const PacketMask& mask, const PacketFloat& a, const PacketFloat& b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask.m, a.v), _mm_andnot_ps(mask.m, b.v));
+    }
+
+    __m128 v;
+};
+#else
+struct PacketMask
+{
+    PacketMask(uint32 mask) : m(mask) {}
+    uint32 bits() const { return m; }
+    PacketMask operator|(const PacketMask& o) const { return m | o.m; }
+    PacketMask operator&(const PacketMask& o) const { return m & o.m; }
+
+    uint32 m;
+};
+
+struct PacketFloat
+{
+    PacketFloat() {}
+    explicit PacketFloat(float f) { v[0] = v[1] = v[2] = v[3] = f; }
+    PacketFloat(float f0, float f1, float f2, float f3) { v[0] = f0; v[1] = f1; v[2] = f2; v[3] = f3; }
+
+    float operator[](uint32 lane) const { return v[lane]; }
+    void store(float* f) const { for (int i = 0; i < RAY_PACKET_SIZE; ++i) f[i] = v[i]; }
+
+    PacketFloat operator+(const PacketFloat& o) const { return PacketFloat(v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3]); }
+    PacketFloat operator-(const PacketFloat& o) const { return PacketFloat(v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3]); }
+    PacketFloat operator*(const PacketFloat& o) const { return PacketFloat(v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3]); }
+    PacketFloat operator/(const PacketFloat& o) const { return PacketFloat(v[0] / o.v[0], v[1] / o.v[1], v[2] / o.v[2], v[3] / o.v[3]); }
+    PacketMask operator<(const PacketFloat& o) const { return compare(o, &lessThan); }
+    PacketMask operator<=(const PacketFloat& o) const { return compare(o, &lessEqual); }
+    PacketMask operator>(const PacketFloat& o) const { return o.compare(*this, &lessThan); }
+
+    static PacketFloat min(const PacketFloat& a, const PacketFloat& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+            r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+        return r;
+    }
+
+    static PacketFloat max(const PacketFloat& a, const PacketFloat& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+            r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+        return r;
+    }
+
+    // mask ? a : b, per lane
+    static PacketFloat select(const PacketMask& mask, const PacketFloat& a, const PacketFloat& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+            r.v[i] = (mask.m & (1 << i)) ? a.v[i] : b.v[i];
+        return r;
+    }
+
+    float v[RAY_PACKET_SIZE];
+
+    private:
+        static bool lessThan(float a, float b) { return a < b; }
+        static bool lessEqual(float a, float b) { return a <= b; }
+        PacketMask compare(const PacketFloat& o, bool (*cmp)(float, float)) const
+        {
+            uint32 mask = 0;
+            for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+                if (cmp(v[i], o.v[i]))
+                    mask |= 1 << i;
+            return mask;
+        }
+};
+#endif
+
+/** Up to RAY_PACKET_SIZE rays traced together, in SoA layout. Lanes not set in mask are ignored. */
+struct RayPacket
+{
+    RayPacket(const G3D::Ray* packetRays, uint32 laneMask) : mask(laneMask)
+    {
+        float o[3][RAY_PACKET_SIZE];
+        float d[3][RAY_PACKET_SIZE];
+        float inv[3][RAY_PACKET_SIZE];
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            // unused lanes get a harmless ray, they are masked out anyway
+            rays[i] = (mask & (1 << i)) ? packetRays[i] : G3D::Ray(G3D::Vector3::zero(), G3D::Vector3::unitZ());
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                o[axis][i] = rays[i].origin()[axis];
+                d[axis][i] = rays[i].direction()[axis];
+                inv[axis][i] = 1.f / d[axis][i];
+            }
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            org[axis] = PacketFloat(o[axis][0], o[axis][1], o[axis][2], o[axis][3]);
+            dir[axis] = PacketFloat(d[axis][0], d[axis][1], d[axis][2], d[axis][3]);
+            invDir[axis] = PacketFloat(inv[axis][0], inv[axis][1], inv[axis][2], inv[axis][3]);
+        }
+    }
+
+    PacketFloat org[3];
+    PacketFloat dir[3];
+    PacketFloat invDir[3];
+    G3D::Ray rays[RAY_PACKET_SIZE];
+    uint32 mask;
+};
+
+#endif // _RAYPACKET_H
@@ -342,14 +342,8 @@ class EventMap : private std::map<uint32, uint32>
                 eventId |= (1 << (groupId + 16));
             if (phase && phase < 8)
                 eventId |= (1 << (phase + 24));
-            const_iterator itr = find(time);
-            while (itr != end())
-            {
-                ++time;
-                itr = find(time);
-            }
 
-            insert(std::make_pair(time, eventId));
+            insert(_FindFreeSlot(time), std::make_pair(time, eventId));
         }
 
         // Removes event with specified id and creates new entry for it
@@ -368,14 +362,8 @@ class EventMap : private std::map<uint32, uint32>
             uint32 eventId = begin()->second;
             erase(begin());
             time += _time;
-            const_iterator itr = find(time);
-            while (itr != end())
-            {
-                ++time;
-                itr = find(time);
-            }
 
-            insert(std::make_pair(time, eventId));
+            insert(_FindFreeSlot(time), std::make_pair(time, eventId));
         }
 
         // Removes first event
@@ -452,10 +440,7 @@ class EventMap : private std::map<uint32, uint32>
             for (iterator itr = begin(); itr != end();)
             {
                 if (eventId == (itr->second & 0x0000FFFF))
-                {
-                    erase(itr);
-                    itr = begin();
-                }
+                    erase(itr++);
                 else
                     ++itr;
             }
@@ -469,10 +454,7 @@ class EventMap : private std::map<uint32, uint32>
             for (iterator itr = begin(); itr != end();)
             {
                 if (itr->second & groupMask)
-                {
-                    erase(itr);
-                    itr = begin();
-                }
+                    erase(itr++);
                 else
                     ++itr;
             }
@@ -490,6 +472,19 @@ class EventMap : private std::map<uint32, uint32>
         }
 
     private:
+        // Moves time past the run of already taken slots starting at it, only one event
+        // may be stored per time. Returns the insertion hint for the free slot.
+        iterator _FindFreeSlot(uint32& time)
+        {
+            iterator itr = lower_bound(time);
+            while (itr != end() && itr->first == time)
+            {
+                ++time;
+                ++itr;
+            }
+            return itr;
+        }
+
         uint32 _time;
         uint32 _phase;
 };
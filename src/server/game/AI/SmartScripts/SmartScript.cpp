@@ -94,15 +94,12 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
             }
         }
     }
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-    {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+    if (e >= SMART_EVENT_END || e == SMART_EVENT_LINK)//special handling
+        return;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
-            ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-    }
+    std::vector<uint32> const& events = mEventIndex[e];
+    for (uint32 i = 0; i < events.size(); ++i)
+        ProcessEvent(mEvents[events[i]], unit, var0, var1, bvar, spell, gob);
 }
 
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
@@ -2623,6 +2620,80 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
     // min/max was checked at loading!
     e.timer = urand(uint32(min), uint32(max));
     e.active = e.timer ? false : true;
+    if (!e.active)
+        QueueCooldown(e);
+}
+
+bool SmartScript::IsPolledEvent(uint32 type)
+{
+    switch (type)
+    {
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALT_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_TARGET_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void SmartScript::QueueCooldown(SmartScriptHolder& e)
+{
+    // polled events are updated every tick anyway, stored/timed list events are not indexed
+    if (e.timerQueued || e.GetEventType() == SMART_EVENT_LINK || IsPolledEvent(e.GetEventType()))
+        return;
+
+    if (mEvents.empty() || &e < &mEvents[0] || &e >= &mEvents[0] + mEvents.size())
+        return;
+
+    e.timerQueued = true;
+    mCooldownEvents.push_back(uint32(&e - &mEvents[0]));
+}
+
+void SmartScript::UpdateCooldowns(uint32 const diff)
+{
+    // non polled events never reach ProcessEvent from UpdateTimer, so the list can't change under us
+    for (uint32 i = 0; i < mCooldownEvents.size();)
+    {
+        SmartScriptHolder& e = mEvents[mCooldownEvents[i]];
+        UpdateTimer(e, diff);
+        if (e.active)
+        {
+            e.timerQueued = false;
+            mCooldownEvents[i] = mCooldownEvents.back();
+            mCooldownEvents.pop_back();
+        }
+        else
+            ++i;
+    }
+}
+
+void SmartScript::IndexEvents(uint32 first)
+{
+    for (uint32 i = first; i < mEvents.size(); ++i)
+    {
+        SmartScriptHolder& e = mEvents[i];
+        if (e.GetEventType() >= SMART_EVENT_END)
+            continue;
+
+        mEventIndex[e.GetEventType()].push_back(i);
+        if (IsPolledEvent(e.GetEventType()))
+            mPolledEvents.push_back(i);
+        else if (!e.active)
+            QueueCooldown(e);//fresh events are activated by their first update
+    }
 }
 
 void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
@@ -2655,39 +2726,21 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         }
 
         e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALT_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_TARGET_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            {
-                ProcessEvent(e);
-                if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+        if (IsPolledEvent(e.GetEventType()))//process ONLY timed events
+        {
+            ProcessEvent(e);
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
                 {
-                    e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                    for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
+                    //find the first event which is not the current one and enable it
+                    if (i->event_id > e.event_id)
                     {
-                        //find the first event which is not the current one and enable it
-                        if (i->event_id > e.event_id)
-                        {
-                            i->enableTimed = true;
-                            break;
-                        }
+                        i->enableTimed = true;
+                        break;
                     }
                 }
-                break;
             }
         }
     }
@@ -2704,10 +2757,12 @@ void SmartScript::InstallEvents()
 {
     if (!mInstallEvents.empty())
     {
+        uint32 first = mEvents.size();
         for (SmartAIEventList::iterator i = mInstallEvents.begin(); i != mInstallEvents.end(); ++i)
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        IndexEvents(first);
     }
 }
 
@@ -2718,8 +2773,10 @@ void SmartScript::OnUpdate(uint32 const diff)
 
     InstallEvents();//before UpdateTimers
 
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+    for (std::vector<uint32>::const_iterator i = mPolledEvents.begin(); i != mPolledEvents.end(); ++i)
+        UpdateTimer(mEvents[*i], diff);
+
+    UpdateCooldowns(diff);
 
     if (!mStoredEvents.empty())
         for (SmartAIEventList::iterator i = mStoredEvents.begin(); i != mStoredEvents.end(); ++i)
@@ -2772,6 +2829,7 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             sLog->outDebug(LOG_FILTER_DATABASE_AI, "SmartScript: EventMap for AreaTrigger %u is empty but is using SmartScript.", at->id);
         return;
     }
+    uint32 first = mEvents.size();
     for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
     {
         #ifndef TRINITY_DEBUG
@@ -2792,6 +2850,7 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+    IndexEvents(first);
     if (mEvents.empty() && obj)
         sLog->outErrorDb("SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
     if (mEvents.empty() && at)
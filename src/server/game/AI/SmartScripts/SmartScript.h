@@ -226,6 +226,12 @@ class SmartScript
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
         SmartAIEventList mEvents;
+        // indices into mEvents, bucketed by event type so ProcessEventsFor only touches matching events
+        std::vector<uint32> mEventIndex[SMART_EVENT_END];
+        // events checked on every update (SMART_EVENT_UPDATE and friends)
+        std::vector<uint32> mPolledEvents;
+        // any other event whose cooldown is still running
+        std::vector<uint32> mCooldownEvents;
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         bool mResumeActionList;
@@ -251,6 +257,10 @@ class SmartScript
 
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
+        void IndexEvents(uint32 first);
+        void QueueCooldown(SmartScriptHolder& e);
+        void UpdateCooldowns(uint32 const diff);
+        static bool IsPolledEvent(uint32 type);
 
         void RemoveStoredEvent (uint32 id)
         {
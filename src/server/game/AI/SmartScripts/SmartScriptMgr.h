@@ -1168,6 +1168,7 @@ struct SmartScriptHolder
         entryOrGuid = 0;
         event_id = 0;
         enableTimed = false;
+        timerQueued = false;
     }
     int32 entryOrGuid;
     SmartScriptType source_type;
@@ -1188,6 +1189,7 @@ struct SmartScriptHolder
     bool active;
     bool runOnce;
     bool enableTimed;
+    bool timerQueued;                                       // SmartScript keeps it in its cooldown list
 
 };
 
@@ -738,8 +738,18 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (m_player->isGameMaster())
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
-    for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i)
+    // a kill, loot or cast only needs the criteria referring to that creature, item or spell
+    AchievementCriteriaEntryList const* achievementCriteriaList;
+    if (miscValue1 && AchievementGlobalMgr::IsCriteriaTypeKeyedByMiscValue(type))
+    {
+        achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByMiscValue(type, miscValue1);
+        if (!achievementCriteriaList)
+            return;
+    }
+    else
+        achievementCriteriaList = &sAchievementMgr->GetAchievementCriteriaByType(type);
+
+    for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList->begin(); i != achievementCriteriaList->end(); ++i)
     {
         AchievementCriteriaEntry const* achievementCriteria = (*i);
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
@@ -2172,6 +2182,101 @@ bool AchievementMgr::CanUpdateCriteria(AchievementCriteriaEntry const* criteria,
 }
 
 //==========================================================
+bool AchievementGlobalMgr::IsCriteriaTypeKeyedByMiscValue(AchievementCriteriaTypes type)
+{
+    // must match the miscValue1 checks in AchievementMgr::UpdateAchievementCriteria
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32 AchievementGlobalMgr::GetCriteriaMiscValue(AchievementCriteriaEntry const* criteria)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+            return criteria->kill_creature.creatureID;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+            return criteria->reach_skill_level.skillID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+            return criteria->learn_skill_level.skillID;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+            return criteria->complete_quests_in_zone.zoneID;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+            return criteria->killed_by_creature.creatureEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+            return criteria->complete_quest.questID;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+            return criteria->be_spell_target.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+            return criteria->cast_spell.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+            return criteria->learn_spell.spellID;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+            return criteria->loot_type.lootType;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+            return criteria->own_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+            return criteria->use_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+            return criteria->gain_reputation.factionID;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+            return criteria->do_emote.emoteID;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+            return criteria->equip_item.itemID;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+            return criteria->use_gameobject.goEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+            return criteria->fish_in_gameobject.goEntry;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+            return criteria->learn_skillline_spell.skillLine;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            return criteria->learn_skill_line.skillLine;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+            return criteria->hk_class.classID;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+            return criteria->hk_race.raceID;
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+            return criteria->bg_objective.objectiveId;
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            return criteria->honorable_kill_at_area.areaID;
+        default:
+            return 0;
+    }
+}
+
 void AchievementGlobalMgr::LoadAchievementCriteriaList()
 {
     uint32 oldMSTime = getMSTime();
@@ -2191,6 +2296,8 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
             continue;
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
+        if (IsCriteriaTypeKeyedByMiscValue(AchievementCriteriaTypes(criteria->requiredType)))
+            m_AchievementCriteriasByMiscValue[criteria->requiredType][GetCriteriaMiscValue(criteria)].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
 
         if (criteria->timeLimit)
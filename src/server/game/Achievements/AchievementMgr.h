@@ -295,6 +295,17 @@ class AchievementGlobalMgr
             return m_AchievementCriteriasByType[type];
         }
 
+        // criteria of a keyed type whose creature/item/spell/... id equals miscValue, NULL if there are none
+        AchievementCriteriaEntryList const* GetAchievementCriteriaByMiscValue(AchievementCriteriaTypes type, uint32 miscValue) const
+        {
+            AchievementCriteriaListByMiscValue::const_iterator itr = m_AchievementCriteriasByMiscValue[type].find(miscValue);
+            return itr != m_AchievementCriteriasByMiscValue[type].end() ? &itr->second : NULL;
+        }
+
+        // types where a non zero miscValue1 only ever matches criteria referring to that id
+        static bool IsCriteriaTypeKeyedByMiscValue(AchievementCriteriaTypes type);
+        static uint32 GetCriteriaMiscValue(AchievementCriteriaEntry const* criteria);
+
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
             return m_AchievementCriteriasByTimedType[type];
@@ -352,6 +363,9 @@ class AchievementGlobalMgr
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         AchievementCriteriaEntryList m_AchievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
+        // keyed criteria types, by the id the criteria refers to
+        typedef UNORDERED_MAP<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByMiscValue;
+        AchievementCriteriaListByMiscValue m_AchievementCriteriasByMiscValue[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
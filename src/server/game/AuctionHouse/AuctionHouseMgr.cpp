@@ -407,6 +407,13 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id)
     return true;
 }
 
+void AuctionHouseMgr::ClearSearchNames()
+{
+    mHordeAuctions.ClearSearchNames();
+    mAllianceAuctions.ClearSearchNames();
+    mNeutralAuctions.ClearSearchNames();
+}
+
 void AuctionHouseMgr::Update()
 {
     mHordeAuctions.Update();
@@ -459,12 +466,21 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    ExpiryQueue.push(AuctionExpiry(auction->expire_time, auction->Id));
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->item_template))
+        IndexAuction(auction, proto);
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*item_template*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->item_template))
+        UnindexAuction(auction, proto);
+
+    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        SearchNames[i].erase(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -478,24 +494,19 @@ void AuctionHouseObject::Update()
     time_t curTime = sWorld->GetGameTime();
     ///- Handle expired auctions
 
-    // If storage is empty, no need to update. next == NULL in this case.
-    if (AuctionsMap.empty())
-        return;
-
-    QueryResult result = CharacterDatabase.PQuery("SELECT id FROM auctionhouse WHERE time <= %u ORDER BY TIME ASC", (uint32)curTime+60);
-
-    if (!result)
-        return;
-
-    do
+    SQLTransaction trans;
+    while (!ExpiryQueue.empty() && ExpiryQueue.top().first <= curTime + 60)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(result->Fetch()->GetUInt32());
+        AuctionExpiry expiry = ExpiryQueue.top();
+        ExpiryQueue.pop();
 
-        if (!auction)
+        // auction was removed (bought out, cancelled) since it was queued
+        AuctionEntry* auction = GetAuction(expiry.second);
+        if (!auction || auction->expire_time != expiry.first)
             continue;
 
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        if (trans.null())
+            trans = CharacterDatabase.BeginTransaction();
 
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0)
@@ -518,12 +529,14 @@ void AuctionHouseObject::Update()
 
         ///- In any case clear the auction
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
 
-        RemoveAuction(auction, item_template);
         sAuctionMgr->RemoveAItem(auction->item_guidlow);
+        RemoveAuction(auction, item_template);
     }
-    while (result->NextRow());
+
+    ///- All auctions expired in this update go out in one transaction
+    if (!trans.null())
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -556,95 +569,229 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-    std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
-    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-    uint32& count, uint32& totalcount)
+void AuctionHouseObject::IndexAuction(AuctionEntry* auction, ItemTemplate const* proto)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
+    ClassIndex[proto->Class].insert(auction->Id);
+    SubClassIndex[(proto->Class << 16) | proto->SubClass].insert(auction->Id);
+    InventoryTypeIndex[proto->InventoryType].insert(auction->Id);
+    QualityIndex[proto->Quality].insert(auction->Id);
+    LevelIndex[proto->RequiredLevel].insert(auction->Id);
+}
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
-    {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
-        if (!item)
-            continue;
+static void EraseFromIndex(std::map<uint32, std::set<uint32> >& index, uint32 key, uint32 id)
+{
+    std::map<uint32, std::set<uint32> >::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
 
-        ItemTemplate const* proto = item->GetTemplate();
+    itr->second.erase(id);
+    if (itr->second.empty())
+        index.erase(itr);
+}
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+void AuctionHouseObject::UnindexAuction(AuctionEntry* auction, ItemTemplate const* proto)
+{
+    EraseFromIndex(ClassIndex, proto->Class, auction->Id);
+    EraseFromIndex(SubClassIndex, (proto->Class << 16) | proto->SubClass, auction->Id);
+    EraseFromIndex(InventoryTypeIndex, proto->InventoryType, auction->Id);
+    EraseFromIndex(QualityIndex, proto->Quality, auction->Id);
+    EraseFromIndex(LevelIndex, proto->RequiredLevel, auction->Id);
+}
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
+AuctionHouseObject::AuctionIdSet const* AuctionHouseObject::FindIndexed(AuctionIndex const& index, uint32 key) const
+{
+    AuctionIndex::const_iterator itr = index.find(key);
+    return itr != index.end() ? &itr->second : NULL;
+}
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
+void AuctionHouseObject::ClearSearchNames()
+{
+    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        SearchNames[i].clear();
+}
 
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
+std::wstring const& AuctionHouseObject::GetSearchName(AuctionEntry* auction, Item* item, ItemTemplate const* proto, int loc_idx, int locdbc_idx)
+{
+    AuctionNameMap& names = SearchNames[loc_idx >= 0 && loc_idx < TOTAL_LOCALES ? loc_idx : LOCALE_enUS];
+    AuctionNameMap::const_iterator itr = names.find(auction->Id);
+    if (itr != names.end())
+        return itr->second;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
+    // an empty name never matches, same as a name that fails the conversion
+    std::wstring& wname = names[auction->Id];
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
+    std::string name = proto->Name1;
+    if (name.empty())
+        return wname;
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
+    // local name
+    if (loc_idx >= 0)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
 
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
 
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+        //  even though the DBC names seem misleading
+        const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
 
-            if (propRefID)
+        if (itemRandProp)
+        {
+            char* const* temp = itemRandProp->nameSuffix;
+
+            // dbc local name
+            if (temp)
             {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* const* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
+                // Append the suffix (ie: of the Monkey) to the name using localization
+                // or default enUS if localization is invalid
+                name += ' ';
+                name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
             }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
         }
+    }
+
+    if (!Utf8toWStr(name, wname))
+        wname.clear();
+    else
+        wstrToLower(wname);
+
+    return wname;
+}
+
+void AuctionHouseObject::ListAuctionItem(WorldPacket& data, Player* player, AuctionEntry* Aentry,
+    std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
+    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+    int loc_idx, int locdbc_idx, uint32& count, uint32& totalcount)
+{
+    Item* item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
+    if (!item)
+        return;
+
+    ItemTemplate const* proto = item->GetTemplate();
+
+    if (itemClass != 0xffffffff && proto->Class != itemClass)
+        return;
+
+    if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
+        return;
+
+    if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+        return;
+
+    if (quality != 0xffffffff && proto->Quality != quality)
+        return;
+
+    if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+        return;
+
+    if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+        return;
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    // No need to do any of this if no search term was entered
+    if (!wsearchedname.empty())
+    {
+        std::wstring const& name = GetSearchName(Aentry, item, proto, loc_idx, locdbc_idx);
+        if (name.find(wsearchedname) == std::wstring::npos)
+            return;
+    }
 
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
+    // Add the item if no search term or if entered search term was found
+    if (count < 50 && totalcount >= listfrom)
+    {
+        ++count;
+        Aentry->BuildAuctionInfo(data);
+    }
+    ++totalcount;
+}
+
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
+    std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
+    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+    uint32& count, uint32& totalcount)
+{
+    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
+    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
+
+    // Walk the smallest index bucket that covers the filters, every filter is still checked per auction
+    AuctionIdSet const* candidates = NULL;
+    bool indexed = false;
+    if (itemClass != 0xffffffff)
+    {
+        if (itemSubClass != 0xffffffff)
+            candidates = FindIndexed(SubClassIndex, (itemClass << 16) | itemSubClass);
+        else
+            candidates = FindIndexed(ClassIndex, itemClass);
+        indexed = true;
+    }
+
+    if (inventoryType != 0xffffffff && (!indexed || candidates))
+    {
+        AuctionIdSet const* byType = FindIndexed(InventoryTypeIndex, inventoryType);
+        if (!indexed || !byType || byType->size() < candidates->size())
+            candidates = byType;
+        indexed = true;
+    }
+
+    if (quality != 0xffffffff && (!indexed || candidates))
+    {
+        AuctionIdSet const* byQuality = FindIndexed(QualityIndex, quality);
+        if (!indexed || !byQuality || byQuality->size() < candidates->size())
+            candidates = byQuality;
+        indexed = true;
+    }
+
+    if (levelmin != 0x00 && (!indexed || candidates))
+    {
+        // a level range spans several buckets, they are merged back into id order when they are the smaller choice
+        if (levelmax != 0x00 && levelmax < levelmin)
+            return;
+
+        AuctionIndex::const_iterator begin = LevelIndex.lower_bound(levelmin);
+        AuctionIndex::const_iterator end = levelmax != 0x00 ? LevelIndex.upper_bound(levelmax) : LevelIndex.end();
+
+        uint32 levelCount = 0;
+        for (AuctionIndex::const_iterator itr = begin; itr != end; ++itr)
+            levelCount += itr->second.size();
+
+        if (!indexed || levelCount < candidates->size())
         {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
+            std::vector<uint32> ids;
+            ids.reserve(levelCount);
+            for (AuctionIndex::const_iterator itr = begin; itr != end; ++itr)
+                ids.insert(ids.end(), itr->second.begin(), itr->second.end());
+            std::sort(ids.begin(), ids.end());
+
+            for (std::vector<uint32>::const_iterator itr = ids.begin(); itr != ids.end(); ++itr)
+                if (AuctionEntry* Aentry = GetAuction(*itr))
+                    ListAuctionItem(data, player, Aentry, wsearchedname, listfrom, levelmin, levelmax, usable,
+                        inventoryType, itemClass, itemSubClass, quality, loc_idx, locdbc_idx, count, totalcount);
+            return;
         }
-        ++totalcount;
     }
+
+    if (indexed)
+    {
+        // an empty bucket means nothing can match
+        if (!candidates)
+            return;
+
+        for (AuctionIdSet::const_iterator itr = candidates->begin(); itr != candidates->end(); ++itr)
+            if (AuctionEntry* Aentry = GetAuction(*itr))
+                ListAuctionItem(data, player, Aentry, wsearchedname, listfrom, levelmin, levelmax, usable,
+                    inventoryType, itemClass, itemSubClass, quality, loc_idx, locdbc_idx, count, totalcount);
+        return;
+    }
+
+    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+        ListAuctionItem(data, player, itr->second, wsearchedname, listfrom, levelmin, levelmax, usable,
+            inventoryType, itemClass, itemSubClass, quality, loc_idx, locdbc_idx, count, totalcount);
 }
 
 //this function inserts to WorldPacket auction's data
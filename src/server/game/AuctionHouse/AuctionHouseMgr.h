@@ -20,6 +20,7 @@
 #define _AUCTION_HOUSE_MGR_H
 
 #include <ace/Singleton.h>
+#include <functional>
 
 #include "Common.h"
 #include "DatabaseEnv.h"
@@ -28,6 +29,7 @@
 class Item;
 class Player;
 class WorldPacket;
+struct ItemTemplate;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 
@@ -114,9 +116,40 @@ class AuctionHouseObject
         uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
         uint32& count, uint32& totalcount);
 
+    // drops the cached lowercase search names, they depend on locales_item
+    void ClearSearchNames();
+
   private:
+    typedef std::set<uint32> AuctionIdSet;
+    typedef std::map<uint32, AuctionIdSet> AuctionIndex;
+    typedef UNORDERED_MAP<uint32, std::wstring> AuctionNameMap;
+    typedef std::pair<time_t, uint32> AuctionExpiry;        // expire time, auction id
+    typedef std::priority_queue<AuctionExpiry, std::vector<AuctionExpiry>, std::greater<AuctionExpiry> > AuctionExpiryQueue;
+
+    void IndexAuction(AuctionEntry* auction, ItemTemplate const* proto);
+    void UnindexAuction(AuctionEntry* auction, ItemTemplate const* proto);
+    AuctionIdSet const* FindIndexed(AuctionIndex const& index, uint32 key) const;
+    std::wstring const& GetSearchName(AuctionEntry* auction, Item* item, ItemTemplate const* proto, int loc_idx, int locdbc_idx);
+    void ListAuctionItem(WorldPacket& data, Player* player, AuctionEntry* Aentry,
+        std::wstring const& searchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
+        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+        int loc_idx, int locdbc_idx, uint32& count, uint32& totalcount);
+
     AuctionEntryMap AuctionsMap;
 
+    // earliest expiring auction on top, removed auctions are skipped when popped
+    AuctionExpiryQueue ExpiryQueue;
+
+    // secondary indexes for BuildListAuctionItems, auction ids sorted like AuctionsMap
+    AuctionIndex ClassIndex;                                // key: item class
+    AuctionIndex SubClassIndex;                             // key: item class << 16 | subclass
+    AuctionIndex InventoryTypeIndex;
+    AuctionIndex QualityIndex;
+    AuctionIndex LevelIndex;                                // key: required level, level ranges walk several buckets
+
+    // lowercase "name suffix" strings as matched by searches, filled on first search per locale
+    AuctionNameMap SearchNames[TOTAL_LOCALES];
+
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
 };
@@ -168,6 +201,8 @@ class AuctionHouseMgr
         void AddAItem(Item* it);
         bool RemoveAItem(uint32 id);
 
+        void ClearSearchNames();
+
         void Update();
 
     private:
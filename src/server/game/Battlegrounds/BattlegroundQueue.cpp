@@ -29,7 +29,7 @@
 /***            BATTLEGROUND QUEUE SYSTEM              ***/
 /*********************************************************/
 
-BattlegroundQueue::BattlegroundQueue()
+BattlegroundQueue::BattlegroundQueue() : m_NextJoinSequence(0)
 {
     for (uint32 i = 0; i < BG_TEAMS_COUNT; ++i)
     {
@@ -145,6 +145,8 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     ginfo->ArenaMatchmakerRating     = MatchmakerRating;
     ginfo->OpponentsTeamRating       = 0;
     ginfo->OpponentsMatchmakerRating = 0;
+    ginfo->JoinSequence              = m_NextJoinSequence++;
+    ginfo->IsRatedWaiting            = false;
 
     ginfo->Players.clear();
 
@@ -192,7 +194,9 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
         }
 
         //add GroupInfo to m_QueuedGroups
-        m_QueuedGroups[bracketId][index].push_back(ginfo);
+        _AddToQueue(ginfo, bracketId, index);
+        if (isRated)
+            _AddRatedWaiting(ginfo);
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -233,6 +237,89 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     return ginfo;
 }
 
+void BattlegroundQueue::_AddToQueue(GroupQueueInfo* ginfo, BattlegroundBracketId bracket_id, uint32 index, bool front)
+{
+    GroupsQueueType& queue = m_QueuedGroups[bracket_id][index];
+    ginfo->BracketId = bracket_id;
+    ginfo->QueueIndex = index;
+    ginfo->QueuePosition = front ? queue.insert(queue.begin(), ginfo) : queue.insert(queue.end(), ginfo);
+}
+
+void BattlegroundQueue::_RemoveFromQueue(GroupQueueInfo* ginfo)
+{
+    _RemoveRatedWaiting(ginfo);
+    m_QueuedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->QueuePosition);
+}
+
+// rated teams only ever join the premade queues, whose index matches the team index
+void BattlegroundQueue::_AddRatedWaiting(GroupQueueInfo* ginfo)
+{
+    RatedWaitingGroups& waiting = m_RatedWaiting[ginfo->BracketId][ginfo->QueueIndex];
+    GroupsQueueType& bucket = waiting.Buckets[ginfo->ArenaMatchmakerRating / RATED_ARENA_RATING_BUCKET];
+    ginfo->RatedWaitingPosition = waiting.JoinOrder.insert(waiting.JoinOrder.end(), ginfo);
+    ginfo->RatedBucketPosition = bucket.insert(bucket.end(), ginfo);
+    ginfo->IsRatedWaiting = true;
+}
+
+void BattlegroundQueue::_RemoveRatedWaiting(GroupQueueInfo* ginfo)
+{
+    if (!ginfo->IsRatedWaiting)
+        return;
+
+    RatedWaitingGroups& waiting = m_RatedWaiting[ginfo->BracketId][ginfo->QueueIndex];
+    std::map<uint32, GroupsQueueType>::iterator bucket = waiting.Buckets.find(ginfo->ArenaMatchmakerRating / RATED_ARENA_RATING_BUCKET);
+    bucket->second.erase(ginfo->RatedBucketPosition);
+    if (bucket->second.empty())
+        waiting.Buckets.erase(bucket);
+    waiting.JoinOrder.erase(ginfo->RatedWaitingPosition);
+    ginfo->IsRatedWaiting = false;
+}
+
+/*
+Returns the longest waiting rated team of the given premade queue that is not invited yet and
+either has its matchmaker rating within [minRating, maxRating] or joined before discardTime.
+If after is set, only teams that joined after it and belong to another arena team are considered.
+*/
+GroupQueueInfo* BattlegroundQueue::_SelectRatedTeam(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* after)
+{
+    RatedWaitingGroups& waiting = m_RatedWaiting[bracket_id][index];
+
+    // teams that joined before the discard time are the head of the join order, and any team in
+    // the rating window that joined before the first of them would be one of them as well
+    GroupsQueueType::iterator itr = after ? after->RatedWaitingPosition : waiting.JoinOrder.begin();
+    if (after)
+        ++itr;
+    for (; itr != waiting.JoinOrder.end() && (*itr)->JoinTime < discardTime; ++itr)
+        if (!after || (*itr)->ArenaTeamId != after->ArenaTeamId)
+            return *itr;
+
+    // otherwise take the longest waiting team out of the buckets covering the rating window
+    GroupQueueInfo* selected = NULL;
+    std::map<uint32, GroupsQueueType>::iterator bucket = waiting.Buckets.lower_bound(minRating / RATED_ARENA_RATING_BUCKET);
+    for (; bucket != waiting.Buckets.end() && bucket->first <= maxRating / RATED_ARENA_RATING_BUCKET; ++bucket)
+    {
+        for (GroupsQueueType::iterator gitr = bucket->second.begin(); gitr != bucket->second.end(); ++gitr)
+        {
+            GroupQueueInfo* ginfo = *gitr;
+            // buckets are in join order as well, nothing further in this one can beat the selected team
+            if (selected && ginfo->JoinSequence > selected->JoinSequence)
+                break;
+
+            if (after && (ginfo->JoinSequence <= after->JoinSequence || ginfo->ArenaTeamId == after->ArenaTeamId))
+                continue;
+
+            // the first and last buckets may hold teams just outside the window
+            if (ginfo->ArenaMatchmakerRating < minRating || ginfo->ArenaMatchmakerRating > maxRating)
+                continue;
+
+            selected = ginfo;
+            break;
+        }
+    }
+
+    return selected;
+}
+
 void BattlegroundQueue::PlayerInvitedToBGUpdateAverageWaitTime(GroupQueueInfo* ginfo, BattlegroundBracketId bracket_id)
 {
     uint32 timeInQueue = getMSTimeDiff(ginfo->JoinTime, getMSTime());
@@ -287,7 +374,6 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
 {
     //Player* player = ObjectAccessor::FindPlayer(guid);
 
-    int32 bracket_id = -1;                                     // signed for proper for-loop finish
     QueuedPlayersMap::iterator itr;
 
     //remove player from map, if he's there
@@ -299,39 +385,7 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr, group_itr_tmp;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = (group->Team == HORDE) ? BG_TEAM_HORDE : BG_TEAM_ALLIANCE;
-
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (group_itr_tmp = m_QueuedGroups[bracket_id_tmp][j].begin(); group_itr_tmp != m_QueuedGroups[bracket_id_tmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = group_itr_tmp;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-
-    //player can't be in queue without group, but just in case
-    if (bracket_id == -1)
-    {
-        sLog->outError("BattlegroundQueue: ERROR Cannot find groupinfo for player GUID: %u", GUID_LOPART(guid));
-        return;
-    }
-    sLog->outDebug(LOG_FILTER_BATTLEGROUND, "BattlegroundQueue: Removing player GUID %u, from bracket_id %u", GUID_LOPART(guid), (uint32)bracket_id);
+    sLog->outDebug(LOG_FILTER_BATTLEGROUND, "BattlegroundQueue: Removing player GUID %u, from bracket_id %u", GUID_LOPART(guid), (uint32)group->BracketId);
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
@@ -373,7 +427,7 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
-        m_QueuedGroups[bracket_id][index].erase(group_itr);
+        _RemoveFromQueue(group);
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -428,6 +482,7 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
         // not yet invited
         // set invitation
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
+        _RemoveRatedWaiting(ginfo);
         BattlegroundTypeId bgTypeId = bg->GetTypeID();
         BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bgTypeId, bg->GetArenaType());
         BattlegroundBracketId bracket_id = bg->GetBracketId();
@@ -610,8 +665,9 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
             if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
             {
                 //we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                GroupQueueInfo* ginfo = *itr;
+                _RemoveFromQueue(ginfo);
+                _AddToQueue(ginfo, bracket_id, BG_QUEUE_NORMAL_ALLIANCE + i, true);
             }
         }
     }
@@ -681,12 +737,9 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     //store last ginfo pointer
     GroupQueueInfo* ginfo = m_SelectionPools[teamIndex].SelectedGroups.back();
     //set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].begin();
-    for (; itr_team != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-    if (itr_team == m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end())
+    if (ginfo->BracketId != bracket_id || ginfo->QueueIndex != BG_QUEUE_NORMAL_ALLIANCE + teamIndex)
         return false;
+    GroupsQueueType::iterator itr_team = ginfo->QueuePosition;
     GroupsQueueType::iterator itr_team2 = itr_team;
     ++itr_team2;
     //invite players to other selection pool
@@ -704,19 +757,9 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     {
         //set correct team
         (*itr)->Team = otherTeamId;
-        //add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeam].push_front(*itr);
-        //remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].erase(itr2);
-                break;
-            }
-        }
+        //move team to other queue
+        _RemoveFromQueue(*itr);
+        _AddToQueue(*itr, bracket_id, BG_QUEUE_NORMAL_ALLIANCE + otherTeam, true);
     }
     return true;
 }
@@ -911,51 +954,33 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
         uint32 discardTime = getMSTime() - sBattlegroundMgr->GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
+        GroupQueueInfo* teams[BG_TEAMS_COUNT];
         uint8 found = 0;
         uint8 team = 0;
 
+        // take the group that joined first
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            if (GroupQueueInfo* ginfo = _SelectRatedTeam(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, NULL))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                teams[found++] = ginfo;
+                team = i;
             }
         }
 
         if (!found)
             return;
 
+        // only one faction has a team, its opponent joined the same queue later
         if (found == 1)
-        {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
-            {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr3)->JoinTime < discardTime)
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
-        }
+            if (GroupQueueInfo* ginfo = _SelectRatedTeam(bracket_id, team, arenaMinRating, arenaMaxRating, discardTime, teams[0]))
+                teams[found++] = ginfo;
 
         //if we have 2 teams, then start new arena and invite players!
         if (found == 2)
         {
-            GroupQueueInfo* aTeam = *itr_teams[BG_TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[BG_TEAM_HORDE];
+            GroupQueueInfo* aTeam = teams[BG_TEAM_ALLIANCE];
+            GroupQueueInfo* hTeam = teams[BG_TEAM_HORDE];
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
             {
@@ -973,13 +998,13 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (aTeam->Team != ALLIANCE)
             {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[BG_TEAM_ALLIANCE]);
+                _RemoveFromQueue(aTeam);
+                _AddToQueue(aTeam, bracket_id, BG_QUEUE_PREMADE_ALLIANCE, true);
             }
             if (hTeam->Team != HORDE)
             {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[BG_TEAM_HORDE]);
+                _RemoveFromQueue(hTeam);
+                _AddToQueue(hTeam, bracket_id, BG_QUEUE_PREMADE_HORDE, true);
             }
 
             arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
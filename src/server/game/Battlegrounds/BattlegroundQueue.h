@@ -28,6 +28,7 @@
 typedef std::list<Battleground*> BGFreeSlotQueueType;
 
 #define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
+#define RATED_ARENA_RATING_BUCKET 100                       // matchmaker rating range covered by one bucket of the rated arena index
 
 struct GroupQueueInfo;                                      // type predefinition
 struct PlayerQueueInfo                                      // stores information for players in queue
@@ -51,6 +52,13 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  ArenaMatchmakerRating;                          // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
     uint32  OpponentsMatchmakerRating;                      // for rated arena matches
+    BattlegroundBracketId BracketId;                        // bracket of the queue holding the group
+    uint32  QueueIndex;                                     // BattlegroundQueueGroupTypes of that queue
+    std::list<GroupQueueInfo*>::iterator QueuePosition;     // position in that queue, removal must not search for it
+    uint32  JoinSequence;                                   // join order within the BattlegroundQueue
+    bool    IsRatedWaiting;                                 // rated team not invited yet, listed in the rated arena index
+    std::list<GroupQueueInfo*>::iterator RatedWaitingPosition;  // position in the index, in join order
+    std::list<GroupQueueInfo*>::iterator RatedBucketPosition;   // position in its rating bucket of the index
 };
 
 enum BattlegroundQueueGroupTypes
@@ -120,6 +128,27 @@ class BattlegroundQueue
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+
+        // all changes to m_QueuedGroups go through these, they keep the group's queue position up to date
+        void _AddToQueue(GroupQueueInfo* ginfo, BattlegroundBracketId bracket_id, uint32 index, bool front = false);
+        void _RemoveFromQueue(GroupQueueInfo* ginfo);
+
+        // Rated arena teams waiting for a match, per bracket and premade queue, both in join order and
+        // split by matchmaker rating, so picking the next match does not walk the invited teams and
+        // the ones out of the rating window. Teams leave it when they are invited or leave the queue.
+        struct RatedWaitingGroups
+        {
+            GroupsQueueType JoinOrder;
+            std::map<uint32, GroupsQueueType> Buckets;      // rating / RATED_ARENA_RATING_BUCKET -> teams in join order
+        };
+
+        void _AddRatedWaiting(GroupQueueInfo* ginfo);
+        void _RemoveRatedWaiting(GroupQueueInfo* ginfo);
+        GroupQueueInfo* _SelectRatedTeam(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* after);
+
+        RatedWaitingGroups m_RatedWaiting[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
+        uint32 m_NextJoinSequence;
+
         uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
@@ -194,6 +194,7 @@ void Channel::Join(uint64 p, const char *pass)
 
     PlayerInfo pinfo;
     pinfo.player = p;
+    pinfo.plr = player;
     pinfo.flags = MEMBER_FLAG_NONE;
     players[p] = pinfo;
 
@@ -563,7 +564,7 @@ void Channel::List(Player* player)
         uint32 count  = 0;
         for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
         {
-            Player* member = ObjectAccessor::FindPlayer(i->first);
+            Player* member = GetMember(i->second);
 
             // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
             // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
@@ -745,14 +746,21 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
+Player* Channel::GetMember(PlayerInfo const& info) const
+{
+    // members that joined without being in the world have no cached pointer
+    return info.plr ? info.plr : ObjectAccessor::FindPlayer(info.player);
+}
+
 void Channel::SendToAll(WorldPacket* data, uint64 p)
 {
+    uint32 sender = GUID_LOPART(p);
     for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
     {
-        Player* player = ObjectAccessor::FindPlayer(i->first);
+        Player* player = GetMember(i->second);
         if (player)
         {
-            if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
+            if (!p || !player->GetSocial()->HasIgnore(sender))
                 player->GetSession()->SendPacket(data);
         }
     }
@@ -764,7 +772,7 @@ void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
     {
         if (i->first != who)
         {
-            Player* player = ObjectAccessor::FindPlayer(i->first);
+            Player* player = GetMember(i->second);
             if (player)
                 player->GetSession()->SendPacket(data);
         }
@@ -773,7 +781,8 @@ void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 
 void Channel::SendToOne(WorldPacket* data, uint64 who)
 {
-    Player* player = ObjectAccessor::FindPlayer(who);
+    PlayerList::const_iterator i = players.find(who);
+    Player* player = i != players.end() ? GetMember(i->second) : ObjectAccessor::FindPlayer(who);
     if (player)
         player->GetSession()->SendPacket(data);
 }
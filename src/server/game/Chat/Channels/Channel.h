@@ -121,7 +121,10 @@ class Channel
 {
     struct PlayerInfo
     {
+        PlayerInfo() : player(0), plr(NULL), flags(MEMBER_FLAG_NONE) {}
+
         uint64 player;
+        Player* plr;                                        // cached at join, members leave all channels before logout (Player::CleanupChannels)
         uint8 flags;
 
         bool HasFlag(uint8 flag) const { return flags & flag; }
@@ -201,6 +204,7 @@ class Channel
         void SendToAll(WorldPacket* data, uint64 p = 0);
         void SendToAllButOne(WorldPacket* data, uint64 who);
         void SendToOne(WorldPacket* data, uint64 who);
+        Player* GetMember(PlayerInfo const& info) const;
 
         bool IsOn(uint64 who) const { return players.find(who) != players.end(); }
         bool IsBanned(uint64 guid) const { return banned.find(guid) != banned.end(); }
@@ -259,6 +259,26 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iThreatIndex.clear();
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iThreatIndex[hostileRef->getUnitGuid()] = iThreatList.insert(iThreatList.end(), hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    ThreatIndex::iterator itr = iThreatIndex.find(hostileRef->getUnitGuid());
+    if (itr == iThreatIndex.end() || *itr->second != hostileRef)
+        return;
+
+    iThreatList.erase(itr->second);
+    iThreatIndex.erase(itr);
 }
 
 //============================================================
@@ -268,12 +288,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
     if (!victim)
         return NULL;
 
-    uint64 guid = victim->GetGUID();
-    for (std::list<HostileReference*>::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-        if ((*i) && (*i)->getUnitGuid() == guid)
-            return (*i);
-
-    return NULL;
+    ThreatIndex::const_iterator itr = iThreatIndex.find(victim->GetGUID());
+    return itr != iThreatIndex.end() ? *itr->second : NULL;
 }
 
 //============================================================
@@ -308,7 +324,10 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
+    // dirty is set whenever the order might have changed; a stable sort of a list that is
+    // still in order is a no-op, so a linear check is enough to skip it
+    if (iDirty && iThreatList.size() > 1 &&
+        std::adjacent_find(iThreatList.begin(), iThreatList.end(), Trinity::ThreatOrderPred(true)) != iThreatList.end())
         iThreatList.sort(Trinity::ThreatOrderPred());
 
     iDirty = false;
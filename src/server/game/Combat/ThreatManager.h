@@ -143,13 +143,17 @@ class ThreatManager;
 class ThreatContainer
 {
     private:
+        // list positions by target guid; list iterators stay valid across sort()
+        typedef UNORDERED_MAP<uint64, std::list<HostileReference*>::iterator> ThreatIndex;
+
         std::list<HostileReference*> iThreatList;
+        ThreatIndex iThreatIndex;
         bool iDirty;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* hostileRef) { iThreatList.remove(hostileRef); }
-        void addReference(HostileReference* hostileRef) { iThreatList.push_back(hostileRef); }
+        void remove(HostileReference* hostileRef);
+        void addReference(HostileReference* hostileRef);
         void clearReferences();
 
         // Sort the list if necessary
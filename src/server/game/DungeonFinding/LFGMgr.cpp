@@ -735,7 +735,9 @@ void LFGMgr::OfferContinue(Group* grp)
 */
 LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 {
-    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
+    // Concatenating the whole queue is expensive, only do it when it will be logged
+    if (sLog->IsOutDebug())
+        sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
 
     LfgProposal* pProposal = NULL;
     if (!check.size() || check.size() > MAXGROUPSIZE || !CheckCompatibility(check, pProposal))
@@ -744,14 +746,43 @@ LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
     // Try to match with queued groups
     while (!pProposal && !all.empty())
     {
-        check.push_back(all.front());
+        uint64 candidate = all.front();
         all.pop_front();
+
+        // Groups without a common dungeon with the new one can never be compatible, skip the whole branch
+        if (!ShareDungeons(check.front(), candidate))
+            continue;
+
+        check.push_back(candidate);
         pProposal = FindNewGroups(check, all);
         check.pop_back();
     }
     return pProposal;
 }
 
+/**
+   Check if two queued guids have at least one selected dungeon in common
+
+   @param[in]     guid Queued guid
+   @param[in]     otherGuid Queued guid
+   @return false only if both are queued and their dungeon selections are disjoint
+*/
+bool LFGMgr::ShareDungeons(uint64 guid, uint64 otherGuid)
+{
+    LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+    LfgQueueInfoMap::const_iterator itOther = m_QueueInfoMap.find(otherGuid);
+    if (itQueue == m_QueueInfoMap.end() || itOther == m_QueueInfoMap.end())
+        return true;                                       // Let CheckCompatibility deal with it
+
+    LfgDungeonSet const& dungeons = itQueue->second->dungeons;
+    LfgDungeonSet const& otherDungeons = itOther->second->dungeons;
+    for (LfgDungeonSet::const_iterator it = dungeons.begin(); it != dungeons.end(); ++it)
+        if (otherDungeons.find(*it) != otherDungeons.end())
+            return true;
+
+    return false;
+}
+
 /**
    Check compatibilities between groups
 
@@ -764,7 +795,8 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     if (pProposal)                                         // Do not check anything if we already have a proposal
         return false;
 
-    std::string strGuids = ConcatenateGuids(check);
+    // Only used for logging
+    std::string strGuids = sLog->IsOutDebug() ? ConcatenateGuids(check) : "";
 
     if (check.size() > MAXGROUPSIZE || check.empty())
     {
@@ -776,7 +808,8 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         return true;
 
     // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
+    LfgCompatibleKey key(check);
+    LfgAnswer answer = GetCompatibles(key);
     if (answer != LFG_ANSWER_PENDING)
     {
         sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) compatibles (cached): %d", strGuids.c_str(), answer);
@@ -792,8 +825,9 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
         if (!CheckCompatibility(check, pProposal))          // Group not compatible
         {
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
+            if (sLog->IsOutDebug())
+                sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
+            SetCompatibles(key, false);
             return false;
         }
         check.push_front(frontGuid);
@@ -836,7 +870,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     // Do not match - groups already in a lfgDungeon or too much players
     if (numLfgGroups > 1 || numPlayers > MAXGROUPSIZE)
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         if (numLfgGroups > 1)
             sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
         else
@@ -890,7 +924,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     {
         if (players.size() == numPlayers)
             sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Roles not compatible", strGuids.c_str());
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
 
@@ -914,10 +948,10 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
 
     if (compatibleDungeons.empty())
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
-    SetCompatibles(strGuids, true);
+    SetCompatibles(key, true);
 
     // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
     if (numPlayers != MAXGROUPSIZE)
@@ -1097,37 +1131,70 @@ void LFGMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
 */
 void LFGMgr::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
+    LfgCompatibleKeysMap::iterator itKeys = m_CompatibleKeys.find(guid);
+    if (itKeys == m_CompatibleKeys.end())
+        return;
+
+    std::vector<LfgCompatibleKey> keys;
+    keys.swap(itKeys->second);
+    m_CompatibleKeys.erase(itKeys);
+
+    // Every key is listed under each of its guids, drop it from the other lists too
+    // so a later SetCompatibles with the same key doesn't list it twice
+    for (std::vector<LfgCompatibleKey>::const_iterator it = keys.begin(); it != keys.end(); ++it)
     {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
+        m_CompatibleMap.erase(*it);
+
+        for (uint8 i = 0; i < it->size; ++i)
+        {
+            if (it->guids[i] == guid)
+                continue;
+
+            LfgCompatibleKeysMap::iterator itOther = m_CompatibleKeys.find(it->guids[i]);
+            if (itOther == m_CompatibleKeys.end())
+                continue;
+
+            std::vector<LfgCompatibleKey>& otherKeys = itOther->second;
+            std::vector<LfgCompatibleKey>::iterator itKey = std::find(otherKeys.begin(), otherKeys.end(), *it);
+            if (itKey != otherKeys.end())
+            {
+                *itKey = otherKeys.back();
+                otherKeys.pop_back();
+            }
+
+            if (otherKeys.empty())
+                m_CompatibleKeys.erase(itOther);
+        }
     }
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Guids checked
    @param[in]     compatibles Compatibles or not
 */
-void LFGMgr::SetCompatibles(std::string key, bool compatibles)
+void LFGMgr::SetCompatibles(LfgCompatibleKey const& key, bool compatibles)
 {
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
+    std::pair<LfgCompatibleMap::iterator, bool> result = m_CompatibleMap.insert(LfgCompatibleMap::value_type(key, LfgAnswer(compatibles)));
+    if (!result.second)
+    {
+        result.first->second = LfgAnswer(compatibles);
+        return;
+    }
+
+    for (uint8 i = 0; i < key.size; ++i)
+        m_CompatibleKeys[key.guids[i]].push_back(key);
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Guids checked
    @return 1 (Compatibles), 0 (Not compatibles), -1 (Not set)
 */
-LfgAnswer LFGMgr::GetCompatibles(std::string key)
+LfgAnswer LFGMgr::GetCompatibles(LfgCompatibleKey const& key)
 {
     LfgAnswer answer = LFG_ANSWER_PENDING;
     LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
@@ -1875,6 +1942,39 @@ LfgType LFGMgr::GetDungeonType(uint32 dungeonId)
     return LfgType(dungeon->type);
 }
 
+LfgCompatibleKey::LfgCompatibleKey(LfgGuidList const& check) : size(0)
+{
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && size < MAXGROUPSIZE; ++it)
+        guids[size++] = *it;
+
+    for (uint8 i = size; i < MAXGROUPSIZE; ++i)
+        guids[i] = 0;
+}
+
+bool LfgCompatibleKey::operator<(LfgCompatibleKey const& other) const
+{
+    if (size != other.size)
+        return size < other.size;
+
+    for (uint8 i = 0; i < size; ++i)
+        if (guids[i] != other.guids[i])
+            return guids[i] < other.guids[i];
+
+    return false;
+}
+
+bool LfgCompatibleKey::operator==(LfgCompatibleKey const& other) const
+{
+    if (size != other.size)
+        return false;
+
+    for (uint8 i = 0; i < size; ++i)
+        if (guids[i] != other.guids[i])
+            return false;
+
+    return true;
+}
+
 /**
    Given a list of guids returns the concatenation using | as delimiter
 
@@ -21,6 +21,7 @@
 #include "Common.h"
 #include <ace/Singleton.h>
 #include "LFG.h"
+#include "Group.h"
 
 class LfgGroupData;
 class LfgPlayerData;
@@ -131,7 +132,20 @@ typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
+/// Queue guids of a checked combination, in check order. Used as compatibility cache key
+struct LfgCompatibleKey
+{
+    LfgCompatibleKey(LfgGuidList const& check);
+
+    bool operator<(LfgCompatibleKey const& other) const;
+    bool operator==(LfgCompatibleKey const& other) const;
+
+    uint8 size;                                            ///< Number of guids used
+    uint64 guids[MAXGROUPSIZE];                            ///< Never more than MAXGROUPSIZE groups are combined
+};
+
+typedef std::map<LfgCompatibleKey, LfgAnswer> LfgCompatibleMap;
+typedef std::map<uint64, std::vector<LfgCompatibleKey> > LfgCompatibleKeysMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -323,9 +337,10 @@ class LFGMgr
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
         bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
+        void SetCompatibles(LfgCompatibleKey const& key, bool compatibles);
+        LfgAnswer GetCompatibles(LfgCompatibleKey const& key);
         void RemoveFromCompatibles(uint64 guid);
+        bool ShareDungeons(uint64 guid, uint64 otherGuid);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
@@ -352,6 +367,7 @@ class LFGMgr
         LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
         LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgCompatibleKeysMap m_CompatibleKeys;             ///< Cached compatibility keys by queue guid
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
         LfgProposalMap m_Proposals;                        ///< Current Proposals
@@ -144,7 +144,7 @@ lootForPickPocketed(false), lootForBody(false), m_groupLootTimer(0), lootingGrou
 m_PlayerDamageReq(0), m_lootMoney(0), m_lootRecipient(0), m_lootRecipientGroup(0), m_corpseRemoveTime(0), m_respawnTime(0),
 m_respawnDelay(300), m_corpseDelay(60), m_respawnradius(0.0f), m_reactState(REACT_AGGRESSIVE),
 m_defaultMovementType(IDLE_MOTION_TYPE), m_DBTableGuid(0), m_equipmentId(0), m_AlreadyCallAssistance(false),
-m_AlreadySearchedAssistance(false), m_regenHealth(true), m_AI_locked(false), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
+m_AlreadySearchedAssistance(false), m_regenHealth(true), m_AI_locked(false), m_dormant(false), m_dormantSkippedTime(0), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
 m_creatureInfo(NULL), m_creatureData(NULL), m_formation(NULL)
 {
     m_regenTimer = CREATURE_REGEN_INTERVAL;
@@ -188,6 +188,7 @@ void Creature::AddToWorld()
         AIM_Initialize();
         if (IsVehicle())
             GetVehicleKit()->Install();
+        UpdateRespawnSchedule();
     }
 }
 
@@ -199,6 +200,7 @@ void Creature::RemoveFromWorld()
             m_zoneScript->OnCreatureRemove(this);
         if (m_formation)
             FormationMgr::RemoveCreatureFromGroup(m_formation, this);
+        GetMap()->UnscheduleRespawn(this);
         Unit::RemoveFromWorld();
         sObjectAccessor->RemoveObject(this);
     }
@@ -246,6 +248,8 @@ void Creature::RemoveCorpse(bool setSpawnTime)
     if (setSpawnTime)
         m_respawnTime = time(NULL) + respawnDelay;
 
+    UpdateRespawnSchedule();
+
     float x, y, z, o;
     GetRespawnPosition(x, y, z, &o);
     SetHomePosition(x, y, z, o);
@@ -429,6 +433,12 @@ bool Creature::UpdateEntry(uint32 Entry, uint32 team, const CreatureData* data)
 
 void Creature::Update(uint32 diff)
 {
+    // the map skips dormant creatures (see SkipDormantUpdate), the periodic
+    // recheck catches up with the time skipped since
+    m_dormant = false;
+    diff += m_dormantSkippedTime;
+    m_dormantSkippedTime = 0;
+
     if (IsAIEnabled && TriggerJustRespawned)
     {
         TriggerJustRespawned = false;
@@ -459,30 +469,10 @@ void Creature::Update(uint32 diff)
             sLog->outError("Creature (GUID: %u Entry: %u) in wrong state: JUST_DEAD (1)", GetGUIDLow(), GetEntry());
             break;
         case DEAD:
-        {
-            time_t now = time(NULL);
-            if (m_respawnTime <= now)
-            {
-                bool allowed = IsAIEnabled ? AI()->CanRespawn() : true;     // First check if there are any scripts that object to us respawning
-                if (!allowed)                                               // Will be rechecked on next Update call
-                    break;
-
-                uint64 dbtableHighGuid = MAKE_NEW_GUID(m_DBTableGuid, GetEntry(), HIGHGUID_UNIT);
-                time_t linkedRespawntime = sObjectMgr->GetLinkedRespawnTime(dbtableHighGuid, GetMap()->GetInstanceId());
-                if (!linkedRespawntime)             // Can respawn
-                    Respawn();
-                else                                // the master is dead
-                {
-                    uint64 targetGuid = sObjectMgr->GetLinkedRespawnGuid(dbtableHighGuid);
-                    if (targetGuid == dbtableHighGuid) // if linking self, never respawn (check delayed to next day)
-                        SetRespawnTime(DAY);
-                    else
-                        m_respawnTime = (now > linkedRespawntime ? now : linkedRespawntime)+urand(5, MINUTE); // else copy time from master and add a little
-                    SaveRespawnTime(); // also save to DB immediately
-                }
-            }
+            // only summons, scripted creatures and those whose respawn came due in an inactive cell
+            // get here, the other dead creatures wait in the map's respawn schedule
+            UpdateRespawn();
             break;
-        }
         case CORPSE:
         {
             Unit::Update(diff);
@@ -581,6 +571,61 @@ void Creature::Update(uint32 diff)
     }
 
     sScriptMgr->OnCreatureUpdate(this, diff);
+
+    if (m_deathState == ALIVE && CanBeDormant())
+        m_dormant = true;
+}
+
+// True when Update would find nothing to do until an outside event changes the creature
+bool Creature::CanBeDormant()
+{
+    if (!isAlive() || isInCombat() || IsInEvadeMode() || isSummon() || isCharmed() || IsVehicle())
+        return false;
+
+    if (NeedChangeAI || TriggerJustRespawned || !m_Events.Empty())
+        return false;
+
+    if (!movespline->Finalized() || GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE)
+        return false;
+
+    for (uint8 i = 0; i < CURRENT_MAX_SPELL; ++i)
+        if (m_currentSpells[i])
+            return false;
+
+    if (getAttackTimer(BASE_ATTACK) || getAttackTimer(RANGED_ATTACK) || getAttackTimer(OFF_ATTACK))
+        return false;
+
+    for (uint8 i = 0; i < MAX_REACTIVE; ++i)
+        if (m_reactiveTimer[i])
+            return false;
+
+    // nothing to regenerate
+    Powers power = getPowerType();
+    if (!IsFullHealth() || ((power == POWER_MANA || power == POWER_ENERGY) && GetPower(power) < GetMaxPower(power)))
+        return false;
+
+    if (!m_gameObj.empty() || !m_removedAuras.empty())
+        return false;
+
+    // permanent auras without periodic effects have no duration or tick to update
+    for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
+    {
+        Aura const* aura = itr->second;
+        if (!aura->IsPermanent() || aura->IsArea())
+            return false;
+
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (AuraEffect const* effect = aura->GetEffect(i))
+                if (effect->IsPeriodic())
+                    return false;
+    }
+
+    for (VisibleAuraMap::const_iterator itr = m_visibleAuras.begin(); itr != m_visibleAuras.end(); ++itr)
+        if (itr->second->IsNeedClientUpdate())
+            return false;
+
+    // scripted creatures may run timers out of combat
+    return !GetScriptId() && GetAIName().empty();
 }
 
 void Creature::RegenerateMana()
@@ -1546,6 +1591,58 @@ void Creature::setDeathState(DeathState s)
             SetPhaseMask(GetCreatureData()->phaseMask, false);
         Unit::setDeathState(ALIVE);
     }
+
+    UpdateRespawnSchedule();
+}
+
+void Creature::UpdateRespawn()
+{
+    if (m_deathState != DEAD)
+        return;
+
+    time_t now = time(NULL);
+    if (m_respawnTime <= now)
+    {
+        bool allowed = IsAIEnabled ? AI()->CanRespawn() : true;     // First check if there are any scripts that object to us respawning
+        if (allowed)                                                // Else rechecked on next update
+        {
+            uint64 dbtableHighGuid = MAKE_NEW_GUID(m_DBTableGuid, GetEntry(), HIGHGUID_UNIT);
+            time_t linkedRespawntime = sObjectMgr->GetLinkedRespawnTime(dbtableHighGuid, GetMap()->GetInstanceId());
+            if (!linkedRespawntime)             // Can respawn
+                Respawn();
+            else                                // the master is dead
+            {
+                uint64 targetGuid = sObjectMgr->GetLinkedRespawnGuid(dbtableHighGuid);
+                if (targetGuid == dbtableHighGuid) // if linking self, never respawn (check delayed to next day)
+                    SetRespawnTime(DAY);
+                else
+                    m_respawnTime = (now > linkedRespawntime ? now : linkedRespawntime)+urand(5, MINUTE); // else copy time from master and add a little
+                SaveRespawnTime(); // also save to DB immediately
+            }
+        }
+    }
+
+    UpdateRespawnSchedule();
+}
+
+// Keeps the map's respawn schedule in line with the death state and respawn time
+void Creature::UpdateRespawnSchedule()
+{
+    // summons are never respawned, they keep being updated while dead
+    // so do scripted creatures, CreatureScript::OnUpdate is called for them while dead
+    if (!IsInWorld() || isSummon() || GetScriptId())
+        return;
+
+    if (m_deathState == DEAD)
+        GetMap()->ScheduleRespawn(this);
+    else
+        GetMap()->UnscheduleRespawn(this);
+}
+
+void Creature::SetRespawnTime(uint32 respawn)
+{
+    m_respawnTime = respawn ? time(NULL) + respawn : 0;
+    UpdateRespawnSchedule();
 }
 
 void Creature::Respawn(bool force)
@@ -1612,7 +1709,7 @@ void Creature::ForcedDespawn(uint32 timeMSToDespawn)
     {
         ForcedDespawnDelayEvent* pEvent = new ForcedDespawnDelayEvent(*this);
 
-        m_Events.AddEvent(pEvent, m_Events.CalculateTime(timeMSToDespawn));
+        AddDelayedEvent(pEvent, timeMSToDespawn);
         return;
     }
 
@@ -1857,7 +1954,7 @@ void Creature::CallAssistance()
                     e->AddAssistant((*assistList.begin())->GetGUID());
                     assistList.pop_front();
                 }
-                m_Events.AddEvent(e, m_Events.CalculateTime(sWorld->getIntConfig(CONFIG_CREATURE_FAMILY_ASSISTANCE_DELAY)));
+                AddDelayedEvent(e, sWorld->getIntConfig(CONFIG_CREATURE_FAMILY_ASSISTANCE_DELAY));
             }
         }
     }
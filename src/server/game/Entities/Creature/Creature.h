@@ -73,6 +73,7 @@ enum CreatureFlagsExtra
 
 #define MAX_KILL_CREDIT 2
 #define CREATURE_REGEN_INTERVAL 2 * IN_MILLISECONDS
+#define CREATURE_DORMANT_RECHECK_INTERVAL 1 * IN_MILLISECONDS
 
 #define MAX_CREATURE_QUEST_ITEMS 6
 
@@ -419,8 +420,11 @@ class MapCreature
     friend class Map; //map for moving creatures
     friend class ObjectGridLoader; //grid loader for loading creatures
 
+public:
+    bool IsRespawnScheduled() const { return _respawnScheduleTime != 0; }
+
 protected:
-    MapCreature() : _moveState(CREATURE_CELL_MOVE_NONE) {}
+    MapCreature() : _moveState(CREATURE_CELL_MOVE_NONE), _respawnScheduleTime(0) {}
 
 private:
     Cell _currentCell;
@@ -434,6 +438,8 @@ private:
         _moveState = CREATURE_CELL_MOVE_ACTIVE;
         _newPosition.Relocate(x, y, z, o);
     }
+
+    time_t _respawnScheduleTime;                        // key in the map's respawn schedule, 0 if not scheduled
 };
 
 class Creature : public Unit, public GridObject<Creature>, public MapCreature
@@ -637,8 +643,32 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
 
         time_t const& GetRespawnTime() const { return m_respawnTime; }
         time_t GetRespawnTimeEx() const;
-        void SetRespawnTime(uint32 respawn) { m_respawnTime = respawn ? time(NULL) + respawn : 0; }
+        void SetRespawnTime(uint32 respawn);
         void Respawn(bool force = false);
+        void UpdateRespawn();
+
+        // An idle creature with nothing to update skips its updates until something wakes it up,
+        // or for at most CREATURE_DORMANT_RECHECK_INTERVAL. Only that recheck catches up with the
+        // skipped time, a creature woken up early drops it.
+        bool IsDormant() const { return m_dormant; }
+        void WakeUp() { m_dormant = false; m_dormantSkippedTime = 0; }
+
+        // Called by the map updater before Update, true if this update can be skipped
+        bool SkipDormantUpdate(uint32 diff)
+        {
+            if (!m_dormant || m_dormantSkippedTime + diff >= CREATURE_DORMANT_RECHECK_INTERVAL)
+                return false;
+
+            m_dormantSkippedTime += diff;
+            return true;
+        }
+
+        // Adds an event delay msecs from now, waking the creature up so the event isn't run early with the skipped time
+        void AddDelayedEvent(BasicEvent* event, uint32 delay)
+        {
+            WakeUp();
+            m_Events.AddEvent(event, m_Events.CalculateTime(delay));
+        }
         void SaveRespawnTime();
 
         uint32 GetRespawnDelay() const { return m_respawnDelay; }
@@ -733,6 +763,8 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         void RegenerateMana();
         void RegenerateHealth();
         void Regenerate(Powers power);
+        void UpdateRespawnSchedule();
+        bool CanBeDormant();
         MovementGeneratorType m_defaultMovementType;
         uint32 m_DBTableGuid;                               ///< For new or temporary creatures is 0 for saved it is lowguid
         uint32 m_equipmentId;
@@ -741,6 +773,8 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         bool m_AlreadySearchedAssistance;
         bool m_regenHealth;
         bool m_AI_locked;
+        bool m_dormant;
+        uint32 m_dormantSkippedTime;                        // (msecs) update time skipped while dormant
 
         SpellSchoolMask m_meleeDamageSchoolMask;
         uint32 m_originalEntry;
@@ -74,6 +74,7 @@
 #include "InstanceScript.h"
 #include <cmath>
 #include "AccountMgr.h"
+#include "WhoListCache.h"
 
 #define ZONE_UPDATE_INTERVAL (1*IN_MILLISECONDS)
 
@@ -2401,6 +2402,10 @@ void Player::AddToWorld()
     ///- Do not add/remove the player from the object storage
     ///- It will crash when updating the ObjectAccessor
     ///- The player should only be added when logging in
+    ///- The map's own store follows the player across maps though
+    if (!IsInWorld())
+        GetMap()->AddToObjectStore(this);
+
     Unit::AddToWorld();
 
     for (uint8 i = PLAYER_SLOT_START; i < PLAYER_SLOT_END; ++i)
@@ -2418,6 +2423,7 @@ void Player::RemoveFromWorld()
         StopCastingBindSight();
         UnsummonPetTemporaryIfAny();
         sOutdoorPvPMgr->HandlePlayerLeaveZone(this, m_zoneUpdateId);
+        GetMap()->RemoveFromObjectStore(this);
     }
 
     ///- Do not add/remove the player from the object storage
@@ -2872,6 +2878,10 @@ void Player::SetGMVisible(bool on)
 
         m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GM, GetSession()->GetSecurity());
     }
+
+    // a GM going invisible must drop out of /who right away
+    if (IsInWorld())
+        sWhoListCache->UpdatePlayer(this);
 }
 
 bool Player::IsGroupVisibleFor(Player const* p) const
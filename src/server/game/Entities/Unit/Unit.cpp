@@ -2825,6 +2825,9 @@ void Unit::SetCurrentCastedSpell(Spell* pSpell)
 {
     ASSERT(pSpell);                                         // NULL may be never passed here, use InterruptSpell or InterruptNonMeleeSpells
 
+    if (GetTypeId() == TYPEID_UNIT)
+        ToCreature()->WakeUp();
+
     CurrentSpellTypes CSpellType = pSpell->GetCurrentContainer();
 
     if (pSpell == m_currentSpells[CSpellType]) return;      // avoid breaking self
@@ -3085,6 +3088,9 @@ Aura* Unit::_TryStackingOrRefreshingExistingAura(SpellInfo const* newAura, uint8
 void Unit::_AddAura(UnitAura* aura, Unit* caster)
 {
     ASSERT(!m_cleanupDone);
+
+    if (GetTypeId() == TYPEID_UNIT)
+        ToCreature()->WakeUp();
     m_ownedAuras.insert(AuraMap::value_type(aura->GetId(), aura));
 
     _RemoveNoStackAurasDueToAura(aura);
@@ -3170,6 +3176,9 @@ void Unit::_ApplyAura(AuraApplication * aurApp, uint8 effMask)
 {
     Aura* aura = aurApp->GetBase();
 
+    if (GetTypeId() == TYPEID_UNIT)
+        ToCreature()->WakeUp();
+
     _RemoveNoStackAurasDueToAura(aura);
 
     if (aurApp->GetRemoveMode())
@@ -11909,6 +11918,9 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
     if (isInCombat() || HasUnitState(UNIT_STAT_EVADE))
         return;
 
+    if (GetTypeId() == TYPEID_UNIT)
+        ToCreature()->WakeUp();
+
     SetFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IN_COMBAT);
 
     if (Creature* creature = ToCreature())
@@ -13413,6 +13425,9 @@ void Unit::SetLevel(uint8 lvl)
 
 void Unit::SetHealth(uint32 val)
 {
+    if (GetTypeId() == TYPEID_UNIT)
+        ToCreature()->WakeUp();
+
     if (getDeathState() == JUST_DIED)
         val = 0;
     else if (GetTypeId() == TYPEID_PLAYER && getDeathState() == DEAD)
@@ -13476,6 +13491,9 @@ void Unit::SetPower(Powers power, uint32 val)
     if (GetPower(power) == val)
         return;
 
+    if (GetTypeId() == TYPEID_UNIT)
+        ToCreature()->WakeUp();
+
     uint32 maxPower = GetMaxPower(power);
     if (maxPower < val)
         val = maxPower;
@@ -102,6 +102,25 @@ Object* ObjectAccessor::GetObjectByTypeMask(WorldObject const& p, uint64 guid, u
     return NULL;
 }
 
+Corpse* ObjectAccessor::GetObjectInMap(uint64 guid, Map* map, Corpse* /*typeSpecifier*/)
+{
+    ASSERT(map);
+    if (Corpse* corpse = GetObjectInWorld(guid, (Corpse*)NULL))
+        if (corpse->GetMap() == map)
+            return corpse;
+    return NULL;
+}
+
+void ObjectAccessor::AddObject(Corpse* corpse)
+{
+    HashMapHolder<Corpse>::Insert(corpse);
+}
+
+void ObjectAccessor::RemoveObject(Corpse* corpse)
+{
+    HashMapHolder<Corpse>::Remove(corpse);
+}
+
 Corpse* ObjectAccessor::GetCorpse(WorldObject const& u, uint64 guid)
 {
     return GetObjectInMap(guid, u.GetMap(), (Corpse*)NULL);
@@ -389,6 +408,9 @@ void ObjectAccessor::UnloadAll()
 
 template <class T> UNORDERED_MAP< uint64, T* > HashMapHolder<T>::m_objectMap;
 template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::i_shards[HashMapHolder<T>::SHARD_COUNT];
+template <class T> ACE_Atomic_Op<ACE_Thread_Mutex, long> HashMapHolder<T>::i_finds;
+template <class T> ACE_Atomic_Op<ACE_Thread_Mutex, long> HashMapHolder<T>::i_contendedFinds;
 
 /// Global definitions for the hashmap storage
 
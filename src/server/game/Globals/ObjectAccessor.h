@@ -22,6 +22,7 @@
 #include "Define.h"
 #include <ace/Singleton.h>
 #include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 #include "UnorderedMap.h"
 
 #include "UpdateData.h"
@@ -50,36 +51,74 @@ class HashMapHolder
         typedef UNORDERED_MAP<uint64, T*> MapType;
         typedef ACE_RW_Thread_Mutex LockType;
 
+        // Find only locks the shard owning the guid, so map threads looking up objects don't
+        // serialize on one lock. The full map and its lock remain for code iterating all objects.
+        static const uint32 SHARD_COUNT = 16;
+
         static void Insert(T* o)
         {
+            uint64 guid = o->GetGUID();
             TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap[o->GetGUID()] = o;
+            m_objectMap[guid] = o;
+
+            Shard& shard = GetShard(guid);
+            ACE_Write_Guard<LockType> shardGuard(shard.lock);
+            shard.objects[guid] = o;
         }
 
         static void Remove(T* o)
         {
+            uint64 guid = o->GetGUID();
             TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap.erase(o->GetGUID());
+            m_objectMap.erase(guid);
+
+            Shard& shard = GetShard(guid);
+            ACE_Write_Guard<LockType> shardGuard(shard.lock);
+            shard.objects.erase(guid);
         }
 
         static T* Find(uint64 guid)
         {
-            TRINITY_READ_GUARD(LockType, i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            ++i_finds;
+
+            Shard& shard = GetShard(guid);
+            ACE_Read_Guard<LockType> guard(shard.lock, 0);
+            if (!guard.locked())
+            {
+                ++i_contendedFinds;
+                guard.acquire_read();
+            }
+
+            typename MapType::const_iterator itr = shard.objects.find(guid);
+            return (itr != shard.objects.end()) ? itr->second : NULL;
         }
 
         static MapType& GetContainer() { return m_objectMap; }
 
         static LockType* GetLock() { return &i_lock; }
 
+        // number of Find calls, and how many of them had to wait for an Insert/Remove on their shard
+        static long GetFinds() { return i_finds.value(); }
+        static long GetContendedFinds() { return i_contendedFinds.value(); }
+
     private:
 
+        struct Shard
+        {
+            LockType lock;
+            MapType objects;
+        };
+
+        static Shard& GetShard(uint64 guid) { return i_shards[uint32(guid) & (SHARD_COUNT - 1)]; }
+
         //Non instanceable only static
         HashMapHolder() {}
 
         static LockType i_lock;
         static MapType  m_objectMap;
+        static Shard    i_shards[SHARD_COUNT];
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> i_finds;
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> i_contendedFinds;
 };
 
 class ObjectAccessor
@@ -136,16 +175,27 @@ class ObjectAccessor
             return (Unit*)GetObjectInWorld(guid, (Creature*)NULL);
         }
 
-        // returns object if is in map
+        // returns object if is in map, looked up in the map's own store
         template<class T> static T* GetObjectInMap(uint64 guid, Map* map, T* /*typeSpecifier*/)
         {
             ASSERT(map);
-            if (T * obj = GetObjectInWorld(guid, (T*)NULL))
-                if (obj->GetMap() == map)
-                    return obj;
-            return NULL;
+            return map->FindInObjectStore(guid, (T*)NULL);
         }
 
+        static Unit* GetObjectInMap(uint64 guid, Map* map, Unit* /*typeSpecifier*/)
+        {
+            if (IS_PLAYER_GUID(guid))
+                return (Unit*)GetObjectInMap(guid, map, (Player*)NULL);
+
+            if (IS_PET_GUID(guid))
+                return (Unit*)GetObjectInMap(guid, map, (Pet*)NULL);
+
+            return (Unit*)GetObjectInMap(guid, map, (Creature*)NULL);
+        }
+
+        // corpses are not kept in map stores
+        static Corpse* GetObjectInMap(uint64 guid, Map* map, Corpse* /*typeSpecifier*/);
+
         template<class T> static T* GetObjectInWorld(uint32 mapid, float x, float y, uint64 guid, T* /*fake*/)
         {
             T* obj = HashMapHolder<T>::Find(guid);
@@ -212,16 +262,27 @@ class ObjectAccessor
         //    return HashMapHolder<GameObject>::GetContainer();
         //}
 
+        // must be called with AddToWorld/RemoveFromWorld, the object is registered
+        // in its map's store as well
         template<class T> static void AddObject(T* object)
         {
             HashMapHolder<T>::Insert(object);
+            object->GetMap()->AddToObjectStore(object);
         }
 
         template<class T> static void RemoveObject(T* object)
         {
             HashMapHolder<T>::Remove(object);
+            object->GetMap()->RemoveFromObjectStore(object);
         }
 
+        // players stay registered while changing maps, Player::AddToWorld handles the map store
+        static void AddObject(Player* player) { HashMapHolder<Player>::Insert(player); }
+        static void RemoveObject(Player* player) { HashMapHolder<Player>::Remove(player); }
+
+        static void AddObject(Corpse* corpse);
+        static void RemoveObject(Corpse* corpse);
+
         static void SaveAllPlayers();
 
         //non-static functions
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WhoListCache.h"
+#include "ObjectAccessor.h"
+#include "GuildMgr.h"
+#include "Player.h"
+#include "WorldSession.h"
+
+bool WhoListCache::_FillInfo(Player* player, WhoListPlayerInfo& info)
+{
+    info.Name = player->GetName();
+    if (!Utf8toWStr(info.Name, info.WideName))
+        return false;
+    wstrToLower(info.WideName);
+
+    info.GuildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
+    if (!Utf8toWStr(info.GuildName, info.WideGuildName))
+        return false;
+    wstrToLower(info.WideGuildName);
+
+    info.Guid = player->GetGUID();
+    info.Team = player->GetTeam();
+    info.Security = player->GetSession()->GetSecurity();
+    info.Visible = player->IsVisible();
+    info.Level = player->getLevel();
+    info.Class = player->getClass();
+    info.Race = player->getRace();
+    info.Gender = player->getGender();
+    info.ZoneId = player->GetZoneId();
+    return true;
+}
+
+void WhoListCache::UpdatePlayer(Player* player)
+{
+    TRINITY_GUARD(LockType, m_lock);
+
+    // the next query rebuilds everything anyway
+    if (!m_valid)
+        return;
+
+    WhoListPlayerInfo info;
+    if (!player->IsInWorld() || !_FillInfo(player, info))
+    {
+        _RemovePlayer(player->GetGUID());
+        return;
+    }
+
+    WhoListIndex::const_iterator itr = m_index.find(info.Guid);
+    if (itr != m_index.end())
+        m_whoList[itr->second] = info;
+    else
+    {
+        m_index[info.Guid] = m_whoList.size();
+        m_whoList.push_back(info);
+    }
+}
+
+void WhoListCache::RemovePlayer(uint64 guid)
+{
+    TRINITY_GUARD(LockType, m_lock);
+    _RemovePlayer(guid);
+}
+
+// must be called with m_lock held
+void WhoListCache::_RemovePlayer(uint64 guid)
+{
+    WhoListIndex::iterator itr = m_index.find(guid);
+    if (itr == m_index.end())
+        return;
+
+    // move the last entry into the hole, the list has no order to keep
+    uint32 pos = itr->second;
+    m_index.erase(itr);
+    if (pos + 1 != m_whoList.size())
+    {
+        m_whoList[pos] = m_whoList.back();
+        m_index[m_whoList[pos].Guid] = pos;
+    }
+    m_whoList.pop_back();
+}
+
+WhoListCache::WhoList const& WhoListCache::GetWhoList()
+{
+    if (!m_valid || GetMSTimeDiffToNow(m_lastRebuild) >= WHO_LIST_REBUILD_INTERVAL)
+        _Rebuild();
+
+    return m_whoList;
+}
+
+// must be called with m_lock held
+void WhoListCache::_Rebuild()
+{
+    WhoList whoList;
+    WhoListIndex index;
+
+    {
+        TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
+        HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
+        whoList.reserve(m.size());
+        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        {
+            Player* player = itr->second;
+
+            //do not process players which are not in world
+            if (!player->IsInWorld())
+                continue;
+
+            WhoListPlayerInfo info;
+            if (!_FillInfo(player, info))
+                continue;
+
+            index[info.Guid] = whoList.size();
+            whoList.push_back(info);
+        }
+    }
+
+    m_whoList.swap(whoList);
+    m_index.swap(index);
+    m_lastRebuild = getMSTime();
+    m_valid = true;
+}
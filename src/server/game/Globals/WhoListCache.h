@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_WHOLISTCACHE_H
+#define TRINITY_WHOLISTCACHE_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+
+#define WHO_LIST_REBUILD_INTERVAL (5 * IN_MILLISECONDS)
+
+class Player;
+
+// what CMSG_WHO needs to know about an online player, names already lowercased for matching
+struct WhoListPlayerInfo
+{
+    uint64 Guid;
+    uint32 Team;
+    AccountTypes Security;
+    bool Visible;                                           // Player::IsVisible()
+    uint8 Level;
+    uint8 Class;
+    uint8 Race;
+    uint8 Gender;
+    uint32 ZoneId;
+    std::string Name;
+    std::wstring WideName;
+    std::string GuildName;
+    std::wstring WideGuildName;
+};
+
+// Snapshot of the players in world, so /who queries don't hold the player storage
+// lock while they scan and convert names. Logins, logouts and GM visibility changes
+// update their entry right away; everything else (level, zone, guild) is refreshed
+// by a full rebuild on the first query once the snapshot is older than
+// WHO_LIST_REBUILD_INTERVAL.
+class WhoListCache
+{
+    friend class ACE_Singleton<WhoListCache, ACE_Null_Mutex>;
+    WhoListCache() : m_lastRebuild(0), m_valid(false) {}
+    ~WhoListCache() {}
+
+    public:
+        typedef std::vector<WhoListPlayerInfo> WhoList;
+        typedef ACE_Thread_Mutex LockType;
+
+        void UpdatePlayer(Player* player);
+        void RemovePlayer(uint64 guid);
+
+        // GetWhoList must be called with GetLock() held, the list stays valid while it is
+        LockType& GetLock() { return m_lock; }
+        WhoList const& GetWhoList();
+
+    private:
+        typedef UNORDERED_MAP<uint64, uint32> WhoListIndex;
+
+        void _Rebuild();
+        void _RemovePlayer(uint64 guid);
+        static bool _FillInfo(Player* player, WhoListPlayerInfo& info);
+
+        WhoList m_whoList;
+        WhoListIndex m_index;                               // guid -> position in m_whoList
+        uint32 m_lastRebuild;
+        bool m_valid;
+        LockType m_lock;
+};
+
+#define sWhoListCache ACE_Singleton<WhoListCache, ACE_Null_Mutex>::instance()
+
+#endif
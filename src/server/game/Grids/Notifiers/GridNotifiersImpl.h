@@ -39,8 +39,9 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 
 inline void Trinity::ObjectUpdater::Visit(CreatureMapType &m)
 {
+    // dead creatures waiting in the map's respawn schedule and dormant ones have nothing to update
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->getSource()->IsInWorld())
+        if (iter->getSource()->IsInWorld() && !iter->getSource()->IsRespawnScheduled() && !iter->getSource()->SkipDormantUpdate(i_timeDiff))
             iter->getSource()->Update(i_timeDiff);
 }
 
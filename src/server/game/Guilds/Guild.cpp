@@ -1704,6 +1704,7 @@ void Guild::HandleMemberLogout(WorldSession* session)
         pMember->SetStats(player);
         pMember->UpdateLogoutTime();
     }
+    m_onlineMembers.erase(player->GetGUIDLow());
     _BroadcastEvent(GE_SIGNED_OFF, player->GetGUID(), player->GetName());
 }
 
@@ -1817,7 +1818,7 @@ void Guild::SendMoneyInfo(WorldSession* session) const
     sLog->outDebug(LOG_FILTER_GUILD, "WORLD: Sent MSG_GUILD_BANK_MONEY_WITHDRAWN");
 }
 
-void Guild::SendLoginInfo(WorldSession* session) const
+void Guild::SendLoginInfo(WorldSession* session)
 {
     WorldPacket data(SMSG_GUILD_EVENT, 1 + 1 + m_motd.size() + 1);
     data << uint8(GE_MOTD);
@@ -1829,6 +1830,10 @@ void Guild::SendLoginInfo(WorldSession* session) const
     SendBankTabsInfo(session);
 
     _BroadcastEvent(GE_SIGNED_ON, session->GetPlayer()->GetGUID(), session->GetPlayer()->GetName());
+
+    // Registered after the sign-on event so the player does not receive his own
+    if (GetMember(session->GetPlayer()->GetGUID()))
+        m_onlineMembers[session->GetPlayer()->GetGUIDLow()] = session->GetPlayer();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2039,27 +2044,30 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, const std:
     {
         WorldPacket data;
         ChatHandler::FillMessageData(&data, session, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, language, NULL, 0, msg.c_str(), NULL);
-        for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (Player* player = itr->second->FindPlayer())
-                if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
-                    !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()))
-                    player->GetSession()->SendPacket(&data);
+        for (OnlineMembers::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        {
+            Player* player = itr->second;
+            if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
+                !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()))
+                player->GetSession()->SendPacket(&data);
+        }
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (itr->second->IsRank(rankId))
-            if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+    for (OnlineMembers::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        Members::const_iterator member = m_members.find(itr->first);
+        if (member != m_members.end() && member->second->IsRank(rankId))
+            itr->second->GetSession()->SendPacket(packet);
+    }
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+    for (OnlineMembers::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        itr->second->GetSession()->SendPacket(packet);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2114,6 +2122,8 @@ bool Guild::AddMember(uint64 guid, uint8 rankId)
         }
     }
     m_members[lowguid] = pMember;
+    if (player)
+        m_onlineMembers[lowguid] = player;
 
     SQLTransaction trans(NULL);
     pMember->SaveToDB(trans);
@@ -2176,6 +2186,7 @@ void Guild::DeleteMember(uint64 guid, bool isDisbanding, bool isKicked)
     if (Member* pMember = GetMember(guid))
         delete pMember;
     m_members.erase(lowguid);
+    m_onlineMembers.erase(lowguid);
 
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (player)
@@ -2715,13 +2726,15 @@ void Guild::_SendBankContentUpdate(uint8 tabId, SlotIds slots) const
             if (slots.find(slotId) != slots.end())
                 pTab->WriteSlotPacket(data, slotId);
 
-        for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (_MemberHasTabRights(itr->second->GetGUID(), tabId, GUILD_BANK_RIGHT_VIEW_TAB))
-                if (Player* player = itr->second->FindPlayer())
-                {
-                    data.put<uint32>(rempos, uint32(_GetMemberRemainingSlots(player->GetGUID(), tabId)));
-                    player->GetSession()->SendPacket(&data);
-                }
+        for (OnlineMembers::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        {
+            Player* player = itr->second;
+            if (_MemberHasTabRights(player->GetGUID(), tabId, GUILD_BANK_RIGHT_VIEW_TAB))
+            {
+                data.put<uint32>(rempos, uint32(_GetMemberRemainingSlots(player->GetGUID(), tabId)));
+                player->GetSession()->SendPacket(&data);
+            }
+        }
 
         sLog->outDebug(LOG_FILTER_NETWORKIO, "WORLD: Sent (SMSG_GUILD_BANK_LIST)");
     }
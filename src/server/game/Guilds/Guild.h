@@ -575,6 +575,7 @@ private:
     };
 
     typedef UNORDERED_MAP<uint32, Member*> Members;
+    typedef UNORDERED_MAP<uint32, Player*> OnlineMembers;
     typedef std::vector<RankInfo> Ranks;
     typedef std::vector<BankTab*> BankTabs;
 
@@ -627,7 +628,7 @@ public:
     void SendBankTabText(WorldSession* session, uint8 tabId) const;
     void SendPermissions(WorldSession* session) const;
     void SendMoneyInfo(WorldSession* session) const;
-    void SendLoginInfo(WorldSession* session) const;
+    void SendLoginInfo(WorldSession* session);
 
     // Load from DB
     bool LoadFromDB(Field* fields);
@@ -681,6 +682,9 @@ protected:
 
     Ranks m_ranks;
     Members m_members;
+    // Members currently in world, keyed by low guid. Broadcasts walk this
+    // instead of resolving every member through ObjectAccessor.
+    OnlineMembers m_onlineMembers;
     BankTabs m_bankTabs;
 
     // These are actually ordered lists. The first element is the oldest entry.
@@ -218,7 +218,7 @@ _creatureToMoveLock(false), i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry),
-i_scriptLock(false)
+i_scriptLock(false), m_localObjectLookups(0)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -562,6 +562,8 @@ void Map::Update(const uint32 t_diff)
         i_scriptLock = false;
     }
 
+    ProcessRespawns();
+
     MoveAllCreaturesInMoveList();
 
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
@@ -570,6 +572,63 @@ void Map::Update(const uint32 t_diff)
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
+void Map::GetCreatureCounts(uint32& total, uint32& dormant) const
+{
+    total = uint32(m_creatureStore.size());
+    dormant = 0;
+    for (UNORDERED_MAP<uint64, Creature*>::const_iterator itr = m_creatureStore.begin(); itr != m_creatureStore.end(); ++itr)
+        if (itr->second->IsDormant())
+            ++dormant;
+}
+
+void Map::ScheduleRespawn(Creature* creature)
+{
+    UnscheduleRespawn(creature);
+
+    // a respawn time already passed is handled on the next update
+    creature->_respawnScheduleTime = std::max(creature->GetRespawnTime(), time_t(1));
+    m_respawnSchedule.insert(std::make_pair(creature->_respawnScheduleTime, creature->GetGUID()));
+}
+
+void Map::UnscheduleRespawn(Creature* creature)
+{
+    if (!creature->_respawnScheduleTime)
+        return;
+
+    m_respawnSchedule.erase(std::make_pair(creature->_respawnScheduleTime, creature->GetGUID()));
+    creature->_respawnScheduleTime = 0;
+}
+
+void Map::ProcessRespawns()
+{
+    time_t now = time(NULL);
+
+    // take the due entries out first, creatures that may not respawn yet schedule themselves again
+    RespawnSchedule::iterator end = m_respawnSchedule.lower_bound(std::make_pair(now + 1, uint64(0)));
+    if (end == m_respawnSchedule.begin())
+        return;
+
+    std::vector<RespawnSchedule::value_type> due(m_respawnSchedule.begin(), end);
+    m_respawnSchedule.erase(m_respawnSchedule.begin(), end);
+
+    for (std::vector<RespawnSchedule::value_type>::const_iterator itr = due.begin(); itr != due.end(); ++itr)
+    {
+        Creature* creature = FindInObjectStore(itr->second, (Creature*)NULL);
+        if (!creature || creature->_respawnScheduleTime != itr->first)
+            continue;
+
+        creature->_respawnScheduleTime = 0;
+
+        // respawns follow cell activity, outside the cells updated this tick the creature
+        // is left to Creature::Update which handles it once its cell gets visited again
+        CellCoord p = Trinity::ComputeCellCoord(creature->GetPositionX(), creature->GetPositionY());
+        if (!isCellMarked(p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord))
+            continue;
+
+        creature->UpdateRespawn();
+    }
+}
+
 struct ResetNotifier
 {
     template<class T>inline void resetNotify(GridRefManager<T> &m)
@@ -727,6 +786,8 @@ Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang
 {
     ASSERT(CheckGridIntegrity(creature, false));
 
+    creature->WakeUp();
+
     Cell old_cell = creature->GetCurrentCell();
     Cell new_cell(x, y);
 
@@ -976,7 +1037,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             }
             // x and y are swapped
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
-            MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+            MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gy, gx);
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
@@ -25,6 +25,7 @@
 #include "DetourNavMeshQuery.h"
 
 #include "Define.h"
+#include "UnorderedMap.h"
 #include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
 
@@ -424,6 +425,27 @@ class Map : public GridRefManager<NGridType>
         GameObject* GetGameObject(uint64 guid);
         DynamicObject* GetDynamicObject(uint64 guid);
 
+        // Guid lookup of objects in world on this map. Only the thread updating the map may
+        // use it, which is why it needs none of the ObjectAccessor locks. Corpses are not
+        // stored here, they may be in world without belonging to a single map.
+        template<class T> void AddToObjectStore(T* obj) { _GetObjectStore((T*)NULL)[obj->GetGUID()] = obj; }
+        template<class T> void RemoveFromObjectStore(T* obj) { _GetObjectStore((T*)NULL).erase(obj->GetGUID()); }
+        template<class T> T* FindInObjectStore(uint64 guid, T* /*typeSpecifier*/)
+        {
+            ++m_localObjectLookups;
+            typename UNORDERED_MAP<uint64, T*>::const_iterator itr = _GetObjectStore((T*)NULL).find(guid);
+            return itr != _GetObjectStore((T*)NULL).end() ? itr->second : NULL;
+        }
+        uint64 GetLocalObjectLookups() const { return m_localObjectLookups; }
+
+        // Dead creatures wait here for their respawn time instead of polling it every update
+        void ScheduleRespawn(Creature* creature);
+        void UnscheduleRespawn(Creature* creature);
+        uint32 GetPendingRespawnCount() const { return uint32(m_respawnSchedule.size()); }
+
+        // Creatures in world on this map, and how many of them are dormant, see Creature::IsDormant
+        void GetCreatureCounts(uint32& total, uint32& dormant) const;
+
         MapInstanced* ToMapInstanced(){ if (Instanceable())  return reinterpret_cast<MapInstanced*>(this); else return NULL;  }
         const MapInstanced* ToMapInstanced() const { if (Instanceable())  return (const MapInstanced*)((MapInstanced*)this); else return NULL;  }
 
@@ -527,6 +549,24 @@ class Map : public GridRefManager<NGridType>
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
 
+        UNORDERED_MAP<uint64, Player*>& _GetObjectStore(Player* /*typeSpecifier*/) { return m_playerStore; }
+        UNORDERED_MAP<uint64, Creature*>& _GetObjectStore(Creature* /*typeSpecifier*/) { return m_creatureStore; }
+        UNORDERED_MAP<uint64, Pet*>& _GetObjectStore(Pet* /*typeSpecifier*/) { return m_petStore; }
+        UNORDERED_MAP<uint64, GameObject*>& _GetObjectStore(GameObject* /*typeSpecifier*/) { return m_gameObjectStore; }
+        UNORDERED_MAP<uint64, DynamicObject*>& _GetObjectStore(DynamicObject* /*typeSpecifier*/) { return m_dynamicObjectStore; }
+
+        UNORDERED_MAP<uint64, Player*> m_playerStore;
+        UNORDERED_MAP<uint64, Creature*> m_creatureStore;
+        UNORDERED_MAP<uint64, Pet*> m_petStore;
+        UNORDERED_MAP<uint64, GameObject*> m_gameObjectStore;
+        UNORDERED_MAP<uint64, DynamicObject*> m_dynamicObjectStore;
+        uint64 m_localObjectLookups;
+
+        void ProcessRespawns();
+
+        typedef std::set<std::pair<time_t, uint64> > RespawnSchedule;
+        RespawnSchedule m_respawnSchedule;
+
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
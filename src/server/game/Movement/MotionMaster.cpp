@@ -514,6 +514,9 @@ void MotionMaster::MoveDistract(uint32 timer)
 
 void MotionMaster::Mutate(MovementGenerator *m, MovementSlot slot)
 {
+    if (i_owner->GetTypeId() == TYPEID_UNIT)
+        i_owner->ToCreature()->WakeUp();
+
     if (MovementGenerator *curr = Impl[slot])
     {
         Impl[slot] = NULL; // in case a new one is generated in this slot during directdelete
@@ -19,6 +19,7 @@
 #include "Map.h"
 #include "Creature.h"
 #include "PathFinder.h"
+#include "MMapFactory.h"
 #include "Log.h"
 
 #include "DetourCommon.h"
@@ -67,8 +68,23 @@ bool PathInfo::calculate(float destX, float destY, float destZ,
     sLog->outDebug(LOG_FILTER_PATHFINDING, "++ PathInfo::calculate() for %u \n", m_sourceUnit->GetGUIDLow());
 
     // make sure navMesh works - we can run on map w/o mmap
-    if (!m_navMesh || !m_navMeshQuery || !HaveTiles(dest) ||
-            m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING))
+    if (!m_navMesh || !m_navMeshQuery || m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING))
+    {
+        BuildShortcut();
+        m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return true;
+    }
+
+    // tiles are paged in on demand and shared with other instances of this map,
+    // hold them while we work with the navmesh so no other map thread evicts them
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    MMAP::MMapTileHolder tiles(mmap, m_sourceUnit->GetMapId(), start.x, start.y, dest.x, dest.y);
+
+    ACE_RW_Thread_Mutex* navMeshLock = mmap->GetNavMeshLock(m_sourceUnit->GetMapId());
+    ASSERT(navMeshLock);
+    TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, *navMeshLock);
+
+    if (!HaveTiles(dest))
     {
         BuildShortcut();
         m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
@@ -20,6 +20,7 @@
 #include "MoveSpline.h"
 #include "packet_builder.h"
 #include "Unit.h"
+#include "Creature.h"
 
 namespace Movement
 {
@@ -52,6 +53,10 @@ namespace Movement
 
     int32 MoveSplineInit::Launch()
     {
+        // the spline is advanced by the unit's updates
+        if (unit.GetTypeId() == TYPEID_UNIT)
+            unit.ToCreature()->WakeUp();
+
         MoveSpline& move_spline = *unit.movespline;
 
         Location real_position(unit.GetPositionX(),unit.GetPositionY(),unit.GetPositionZ(),unit.GetOrientation());
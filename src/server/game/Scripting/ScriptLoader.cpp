@@ -53,6 +53,7 @@ void AddSC_gobject_commandscript();
 void AddSC_honor_commandscript();
 void AddSC_learn_commandscript();
 void AddSC_misc_commandscript();
+void AddSC_mmaps_commandscript();
 void AddSC_modify_commandscript();
 void AddSC_npc_commandscript();
 void AddSC_quest_commandscript();
@@ -655,6 +656,7 @@ void AddCommandScripts()
     AddSC_honor_commandscript();
     AddSC_learn_commandscript();
     AddSC_misc_commandscript();
+    AddSC_mmaps_commandscript();
     AddSC_modify_commandscript();
     AddSC_npc_commandscript();
     AddSC_quest_commandscript();
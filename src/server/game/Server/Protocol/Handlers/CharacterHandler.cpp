@@ -43,6 +43,7 @@
 #include "ScriptMgr.h"
 #include "Battleground.h"
 #include "AccountMgr.h"
+#include "WhoListCache.h"
 
 class LoginQueryHolder : public SQLQueryHolder
 {
@@ -1015,6 +1016,8 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder * holder)
 
     m_playerLoading = false;
 
+    sWhoListCache->UpdatePlayer(pCurrChar);
+
     sScriptMgr->OnPlayerLogin(pCurrChar);
     delete holder;
 }
@@ -42,6 +42,7 @@
 #include "zlib.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
+#include "WhoListCache.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -484,6 +485,8 @@ void WorldSession::LogoutPlayer(bool Save)
         sSocialMgr->SendFriendStatus(_player, FRIEND_OFFLINE, _player->GetGUIDLow(), true);
         sSocialMgr->RemovePlayerSocial (_player->GetGUIDLow ());
 
+        sWhoListCache->RemovePlayer(_player->GetGUID());
+
         // Call script hook before deletion
         sScriptMgr->OnPlayerLogout(GetPlayer());
 
@@ -54,8 +54,77 @@
 #include "InstanceScript.h"
 #include "SpellInfo.h"
 
+#include <ace/TSS_T.h>
+#include <ace/Atomic_Op.h>
+
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
+// Every cast creates a Spell, so a thread keeps the memory of the ones it freed for its next casts.
+// A Spell freed on another thread than the one that created it simply moves to that thread's list.
+class SpellAllocator
+{
+    public:
+        enum { MAX_FREE_SPELLS = 256 };
+
+        SpellAllocator() { _free.reserve(MAX_FREE_SPELLS); }
+
+        ~SpellAllocator()
+        {
+            for (std::vector<void*>::iterator itr = _free.begin(); itr != _free.end(); ++itr)
+                ::operator delete(*itr);
+        }
+
+        void* Allocate()
+        {
+            if (_free.empty())
+            {
+                ++_heapAllocations;
+                return ::operator new(sizeof(Spell));
+            }
+
+            ++_reusedAllocations;
+            void* ptr = _free.back();
+            _free.pop_back();
+            return ptr;
+        }
+
+        void Free(void* ptr)
+        {
+            if (_free.size() < MAX_FREE_SPELLS)
+                _free.push_back(ptr);
+            else
+                ::operator delete(ptr);
+        }
+
+        // allocations over all threads, shown by .debug mapstats
+        static long GetHeapAllocations() { return _heapAllocations.value(); }
+        static long GetReusedAllocations() { return _reusedAllocations.value(); }
+
+    private:
+        std::vector<void*> _free;
+
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> _heapAllocations;
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> _reusedAllocations;
+};
+
+ACE_Atomic_Op<ACE_Thread_Mutex, long> SpellAllocator::_heapAllocations;
+ACE_Atomic_Op<ACE_Thread_Mutex, long> SpellAllocator::_reusedAllocations;
+
+typedef ACE_TSS<SpellAllocator> SpellAllocatorTSS;
+static SpellAllocatorTSS spellAllocator;
+
+// Containers reused by the target selection of all spells cast on a thread; target selection
+// never nests, so each of them is only in use by one spell at a time
+struct SpellTargetScratch
+{
+    std::vector<Unit*> AreaTargets;
+    std::vector<Unit*> ChainTargets;
+    std::vector<VMAP::LineOfSightQuery> LOSQueries;
+};
+
+typedef ACE_TSS<SpellTargetScratch> SpellTargetScratchTSS;
+static SpellTargetScratchTSS spellTargetScratch;
+
 SpellCastTargets::SpellCastTargets() : m_elevation(0), m_speed(0)
 {
     m_objectTarget = NULL;
@@ -592,6 +661,35 @@ Spell::~Spell()
     CheckEffectExecuteData();
 }
 
+void* Spell::operator new(size_t size)
+{
+    if (size != sizeof(Spell))
+        return ::operator new(size);
+
+    return spellAllocator->Allocate();
+}
+
+void Spell::operator delete(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size != sizeof(Spell))
+        ::operator delete(ptr);
+    else
+        spellAllocator->Free(ptr);
+}
+
+long Spell::GetHeapAllocations()
+{
+    return SpellAllocator::GetHeapAllocations();
+}
+
+long Spell::GetReusedAllocations()
+{
+    return SpellAllocator::GetReusedAllocations();
+}
+
 template<typename T>
 WorldObject* Spell::FindCorpseUsing()
 {
@@ -1780,15 +1878,18 @@ void Spell::SearchChainTarget(std::list<Unit*> &TagUnitMap, float max_range, uin
     if (m_spellInfo->DmgClass != SPELL_DAMAGE_CLASS_MELEE)
         max_range += num * CHAIN_SPELL_JUMP_RADIUS;
 
-    std::list<Unit*> tempUnitMap;
+    std::vector<Unit*>& tempUnitMap = spellTargetScratch->ChainTargets;
+    tempUnitMap.clear();
     if (TargetType == SPELL_TARGETS_CHAINHEAL)
     {
         SearchAreaTarget(tempUnitMap, max_range, PUSH_CHAIN, SPELL_TARGETS_ALLY);
-        tempUnitMap.sort(ChainHealingOrder(m_caster));
+        // std::sort is not stable (the std::list::sort used before was), targets ranked equally may
+        // swap places; their order was only the grid visit order anyway
+        std::sort(tempUnitMap.begin(), tempUnitMap.end(), ChainHealingOrder(m_caster));
     }
     else
         SearchAreaTarget(tempUnitMap, max_range, PUSH_CHAIN, TargetType);
-    tempUnitMap.remove(cur);
+    tempUnitMap.erase(std::remove(tempUnitMap.begin(), tempUnitMap.end(), cur), tempUnitMap.end());
 
     while (num)
     {
@@ -1798,7 +1899,7 @@ void Spell::SearchChainTarget(std::list<Unit*> &TagUnitMap, float max_range, uin
         if (tempUnitMap.empty())
             break;
 
-        std::list<Unit*>::iterator next;
+        std::vector<Unit*>::iterator next;
 
         if (TargetType == SPELL_TARGETS_CHAINHEAL)
         {
@@ -1812,7 +1913,8 @@ void Spell::SearchChainTarget(std::list<Unit*> &TagUnitMap, float max_range, uin
         }
         else
         {
-            tempUnitMap.sort(Trinity::ObjectDistanceOrderPred(cur));
+            // unstable as well, of targets at the same distance any may jump first
+            std::sort(tempUnitMap.begin(), tempUnitMap.end(), Trinity::ObjectDistanceOrderPred(cur));
             next = tempUnitMap.begin();
 
             if (cur->GetDistance(*next) > CHAIN_SPELL_JUMP_RADIUS)      // Don't search beyond the max jump radius
@@ -1839,6 +1941,14 @@ void Spell::SearchChainTarget(std::list<Unit*> &TagUnitMap, float max_range, uin
 }
 
 void Spell::SearchAreaTarget(std::list<Unit*> &TagUnitMap, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry)
+{
+    std::vector<Unit*>& unitList = spellTargetScratch->AreaTargets;
+    unitList.clear();
+    SearchAreaTarget(unitList, radius, type, TargetType, entry);
+    TagUnitMap.insert(TagUnitMap.end(), unitList.begin(), unitList.end());
+}
+
+void Spell::SearchAreaTarget(std::vector<Unit*> &TagUnitMap, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry)
 {
     if (TargetType == SPELL_TARGETS_GO)
         return;
@@ -2468,8 +2578,10 @@ uint32 Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
 
             CallScriptAfterUnitTargetSelectHandlers(unitList, SpellEffIndex(i));
 
+            PrefetchTargetLOS(unitList);
             for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
                 AddUnitTarget(*itr, effectMask, false);
+            m_targetLOS.clear();
         }
         else
             AddUnitTarget(target, effectMask, false);
@@ -2823,8 +2935,10 @@ uint32 Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
 
             CallScriptAfterUnitTargetSelectHandlers(unitList, SpellEffIndex(i));
 
+            PrefetchTargetLOS(unitList);
             for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
                 AddUnitTarget(*itr, effectMask, false);
+            m_targetLOS.clear();
         }
 
         if (!gobjectList.empty())
@@ -6405,14 +6519,73 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
                 caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
             if (!caster)
                 caster = m_caster;
-            if (target != m_caster && !target->IsWithinLOSInMap(caster))
-                return false;
+            if (target != m_caster)
+            {
+                TargetLOSMap::const_iterator los = std::lower_bound(m_targetLOS.begin(), m_targetLOS.end(), std::make_pair(target->GetGUID(), false));
+                if (los != m_targetLOS.end() && los->first == target->GetGUID() ? !los->second : !target->IsWithinLOSInMap(caster))
+                    return false;
+            }
             break;
     }
 
     return true;
 }
 
+void Spell::PrefetchTargetLOS(std::list<Unit*> const& unitList)
+{
+    m_targetLOS.clear();
+
+    // same conditions as the normal case of CheckEffectTarget, anything else keeps checking one by one
+    if (unitList.size() < 2 || IsTriggered() || m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS)
+        return;
+
+    WorldObject* caster = NULL;
+    if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+
+    std::vector<VMAP::LineOfSightQuery>& queries = spellTargetScratch->LOSQueries;
+    queries.clear();
+    m_targetLOS.reserve(unitList.size());
+    for (std::list<Unit*>::const_iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
+    {
+        Unit* target = *itr;
+        if (target == m_caster)
+            continue;
+
+        if (!target->IsInMap(caster))
+        {
+            m_targetLOS.push_back(std::make_pair(target->GetGUID(), false));
+            continue;
+        }
+
+        // matches WorldObject::IsWithinLOS, traced from the target towards the caster
+        VMAP::LineOfSightQuery query;
+        query.x1 = target->GetPositionX();
+        query.y1 = target->GetPositionY();
+        query.z1 = target->GetPositionZ() + 2.0f;
+        query.x2 = caster->GetPositionX();
+        query.y2 = caster->GetPositionY();
+        query.z2 = caster->GetPositionZ() + 2.0f;
+        queries.push_back(query);
+        m_targetLOS.push_back(std::make_pair(target->GetGUID(), true));
+    }
+
+    if (!queries.empty())
+    {
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(caster->GetMapId(), &queries[0], queries.size());
+
+        // queries were pushed in the same order as the in-map entries of m_targetLOS
+        uint32 query = 0;
+        for (TargetLOSMap::iterator itr = m_targetLOS.begin(); itr != m_targetLOS.end(); ++itr)
+            if (itr->second)
+                itr->second = queries[query++].result;
+    }
+
+    std::sort(m_targetLOS.begin(), m_targetLOS.end());
+}
+
 bool Spell::IsNextMeleeSwingSpell() const
 {
     return m_spellInfo->Attributes & SPELL_ATTR0_ON_NEXT_SWING;
@@ -364,6 +364,13 @@ class Spell
         Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, uint64 originalCasterGUID = 0, bool skipCheck = false);
         ~Spell();
 
+        // Spell objects are recycled through a per-thread free list instead of the general heap
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+        // Spell objects taken from the heap and from the free lists since startup
+        static long GetHeapAllocations();
+        static long GetReusedAllocations();
+
         void prepare(SpellCastTargets const* targets, AuraEffect const* triggeredByAura = NULL);
         void cancel();
         void update(uint32 difftime);
@@ -596,6 +603,11 @@ class Spell
         };
         std::list<ItemTargetInfo> m_UniqueItemInfo;
 
+        // line of sight of area targets, traced as one batch before they are added, sorted by guid
+        typedef std::vector<std::pair<uint64, bool> > TargetLOSMap;
+        TargetLOSMap m_targetLOS;
+        void PrefetchTargetLOS(std::list<Unit*> const& unitList);
+
         void AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid = true);
         void AddGOTarget(GameObject* target, uint32 effectMask);
         void AddGOTarget(uint64 goGUID, uint32 effectMask);
@@ -607,6 +619,7 @@ class Spell
         void DoAllEffectOnTarget(ItemTargetInfo* target);
         bool UpdateChanneledTargetList();
         void SearchAreaTarget(std::list<Unit*> &unitList, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry = 0);
+        void SearchAreaTarget(std::vector<Unit*> &unitList, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry = 0);
         void SearchGOAreaTarget(std::list<GameObject*> &gobjectList, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry = 0);
         void SearchChainTarget(std::list<Unit*> &unitList, float radius, uint32 unMaxTargets, SpellTargets TargetType);
         WorldObject* SearchNearbyTarget(float range, SpellTargets TargetType, SpellEffIndex effIndex);
@@ -674,7 +687,7 @@ namespace Trinity
 {
     struct SpellNotifierCreatureAndPlayer
     {
-        std::list<Unit*> *i_data;
+        std::vector<Unit*> *i_data;
         SpellNotifyPushType i_push_type;
         float i_radius;
         SpellTargets i_TargetType;
@@ -683,7 +696,7 @@ namespace Trinity
         const Position* const i_pos;
         SpellInfo const* i_spellProto;
 
-        SpellNotifierCreatureAndPlayer(Unit* source, std::list<Unit*> &data, float radius, SpellNotifyPushType type,
+        SpellNotifierCreatureAndPlayer(Unit* source, std::vector<Unit*> &data, float radius, SpellNotifyPushType type,
             SpellTargets TargetType = SPELL_TARGETS_ENEMY, const Position* pos = NULL, uint32 entry = 0, SpellInfo const* spellProto = NULL)
             : i_data(&data), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
             i_source(source), i_entry(entry), i_pos(pos), i_spellProto(spellProto)
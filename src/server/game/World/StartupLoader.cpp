@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+#include "DelayExecutor.h"
+#include "DatabaseEnv.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+// Loader threads query the databases directly, so each one registers with the MySQL client library
+class StartupLoaderThreadStart : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class StartupLoaderThreadEnd : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
+class StartupLoaderRequest : public ACE_Method_Request
+{
+    public:
+        StartupLoaderRequest(StartupLoader& loader, StartupLoader::TaskId id) : m_loader(loader), m_id(id) { }
+
+        virtual int call()
+        {
+            m_loader._RunTask(m_id);
+            m_loader._TaskFinished(m_id);
+            return 0;
+        }
+
+    private:
+        StartupLoader& m_loader;
+        StartupLoader::TaskId m_id;
+};
+
+StartupLoader::StartupLoader(char const* batchName) : _batchName(batchName), _executor(NULL), _lock(), _finishedCondition(_lock), _finishedTasks(0)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (std::vector<Task*>::iterator itr = _tasks.begin(); itr != _tasks.end(); ++itr)
+        delete *itr;
+}
+
+StartupLoader::TaskId StartupLoader::Add(char const* name, void (*loader)())
+{
+    return _AddTask(new FunctionTask(name, loader));
+}
+
+StartupLoader::TaskId StartupLoader::_AddTask(Task* task)
+{
+    _tasks.push_back(task);
+    return TaskId(_tasks.size() - 1);
+}
+
+void StartupLoader::AddDependency(TaskId task, TaskId dependency)
+{
+    ASSERT(dependency < task && task < _tasks.size());
+
+    _tasks[dependency]->Dependents.push_back(task);
+    ++_tasks[task]->PendingDependencies;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 oldMSTime = getMSTime();
+
+    if (threads > _tasks.size())
+        threads = uint32(_tasks.size());
+
+    if (threads <= 1)
+    {
+        // dependencies always point to earlier tasks, so the insertion order satisfies them
+        for (TaskId id = 0; id < _tasks.size(); ++id)
+            _RunTask(id);
+    }
+    else
+    {
+        DelayExecutor executor;
+        executor.activate(int(threads), new StartupLoaderThreadStart, new StartupLoaderThreadEnd);
+        _executor = &executor;
+        _finishedTasks = 0;
+
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+            for (TaskId id = 0; id < _tasks.size(); ++id)
+                if (!_tasks[id]->PendingDependencies)
+                    _ScheduleTask(id);
+
+            while (_finishedTasks < _tasks.size())
+                _finishedCondition.wait();
+        }
+
+        executor.deactivate();
+        _executor = NULL;
+    }
+
+    uint32 sequentialTime = 0;
+    for (std::vector<Task*>::const_iterator itr = _tasks.begin(); itr != _tasks.end(); ++itr)
+    {
+        sLog->outString(">> %s: %s took %u ms", _batchName.c_str(), (*itr)->Name.c_str(), (*itr)->Duration);
+        sequentialTime += (*itr)->Duration;
+    }
+
+    sLog->outString(">> %s: %u loaders finished in %u ms using %u thread(s), %u ms of loading in total",
+        _batchName.c_str(), uint32(_tasks.size()), GetMSTimeDiffToNow(oldMSTime), threads > 1 ? threads : 1, sequentialTime);
+    sLog->outString();
+}
+
+void StartupLoader::_RunTask(TaskId id)
+{
+    Task* task = _tasks[id];
+    uint32 oldMSTime = getMSTime();
+    task->Load();
+    task->Duration = GetMSTimeDiffToNow(oldMSTime);
+}
+
+// must be called with _lock held
+void StartupLoader::_ScheduleTask(TaskId id)
+{
+    if (_executor->execute(new StartupLoaderRequest(*this, id)) == -1)
+    {
+        // the executor refused the request, load it here rather than stall the batch
+        sLog->outError("StartupLoader: could not schedule %s, loading it on the calling thread", _tasks[id]->Name.c_str());
+        _RunTask(id);
+        _CompleteTask(id);
+    }
+}
+
+void StartupLoader::_TaskFinished(TaskId id)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    _CompleteTask(id);
+}
+
+// must be called with _lock held
+void StartupLoader::_CompleteTask(TaskId id)
+{
+    ++_finishedTasks;
+
+    std::vector<TaskId> const& dependents = _tasks[id]->Dependents;
+    for (std::vector<TaskId>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+        if (!--_tasks[*itr]->PendingDependencies)
+            _ScheduleTask(*itr);
+
+    _finishedCondition.broadcast();
+}
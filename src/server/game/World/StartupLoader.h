@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_STARTUPLOADER_H
+#define TRINITY_STARTUPLOADER_H
+
+#include "Define.h"
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <string>
+#include <vector>
+
+class DelayExecutor;
+
+/*
+ * Runs a batch of startup Load* functions as a dependency graph.
+ *
+ * A task is only started once every task it depends on has finished, so
+ * independent loaders of the batch can run side by side, each on its own
+ * synchronous database connection. With a single thread the tasks run in the
+ * order they were added, which is the order the batch had before it was made
+ * a graph. Run() returns once the whole batch is loaded and reports how long
+ * each task took.
+ *
+ * Loaders put in the same batch must not write to containers another task of
+ * the batch reads or writes, unless a dependency orders them.
+ */
+class StartupLoader
+{
+    friend class StartupLoaderRequest;
+
+    public:
+        typedef uint32 TaskId;
+
+        explicit StartupLoader(char const* batchName);
+        ~StartupLoader();
+
+        template<class T>
+        TaskId Add(char const* name, T* object, void (T::*loader)())
+        {
+            return _AddTask(new MemberTask<T>(name, object, loader));
+        }
+
+        TaskId Add(char const* name, void (*loader)());
+
+        // dependency must have been added before task
+        void AddDependency(TaskId task, TaskId dependency);
+
+        void Run(uint32 threads);
+
+    private:
+        struct Task
+        {
+            Task(char const* name) : Name(name), PendingDependencies(0), Duration(0) { }
+            virtual ~Task() { }
+
+            virtual void Load() = 0;
+
+            std::string Name;
+            std::vector<TaskId> Dependents;
+            uint32 PendingDependencies;
+            uint32 Duration;
+        };
+
+        template<class T>
+        struct MemberTask : public Task
+        {
+            MemberTask(char const* name, T* object, void (T::*loader)()) : Task(name), _object(object), _loader(loader) { }
+
+            void Load() { (_object->*_loader)(); }
+
+            T* _object;
+            void (T::*_loader)();
+        };
+
+        struct FunctionTask : public Task
+        {
+            FunctionTask(char const* name, void (*loader)()) : Task(name), _loader(loader) { }
+
+            void Load() { _loader(); }
+
+            void (*_loader)();
+        };
+
+        TaskId _AddTask(Task* task);
+        void _RunTask(TaskId id);
+        void _ScheduleTask(TaskId id);
+        void _TaskFinished(TaskId id);
+        void _CompleteTask(TaskId id);
+
+        std::string _batchName;
+        std::vector<Task*> _tasks;
+
+        // scheduling state of a parallel run
+        DelayExecutor* _executor;
+        ACE_Thread_Mutex _lock;
+        ACE_Condition_Thread_Mutex _finishedCondition;
+        uint32 _finishedTasks;
+};
+
+#endif
@@ -39,6 +39,7 @@
 #include "ObjectMgr.h"
 #include "ArenaTeamMgr.h"
 #include "GuildMgr.h"
+#include "StartupLoader.h"
 #include "TicketMgr.h"
 #include "CreatureEventAIMgr.h"
 #include "SpellMgr.h"
@@ -1140,9 +1141,12 @@ void World::LoadConfigSettings(bool reload)
     bool EnablePathfinding = ConfigMgr::GetBoolDefault("mmap.enablePathFinding", true);
     std::string ignoreMapIds = ConfigMgr::GetStringDefault("mmap.ignoreMapIds", "");
 
+    uint32 mmapMemoryBudget = ConfigMgr::GetIntDefault("mmap.memoryBudget", 512);
+
     MMAP::MMapFactory::IsPathfindingEnabled(EnablePathfinding);
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
-    sLog->outString("WORLD: MMap support active %i", EnablePathfinding);
+    MMAP::MMapFactory::createOrGetMMapManager()->setMemoryBudget(uint64(mmapMemoryBudget) * 1024 * 1024);
+    sLog->outString("WORLD: MMap support active %i, memory budget %u MB", EnablePathfinding, mmapMemoryBudget);
     sLog->outString("WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
     m_int_configs[CONFIG_MAX_WHO] = ConfigMgr::GetIntDefault("MaxWhoListReturns", 49);
@@ -1166,6 +1170,17 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = ConfigMgr::GetIntDefault("StartupLoader.Threads", 0);
+    // a loader thread without a synchronous connection of its own would only spin waiting for one
+    uint32 worldSynchConnections = WorldDatabase.GetSynchConnectionCount();
+    if (m_int_configs[CONFIG_STARTUP_LOADER_THREADS] > worldSynchConnections)
+    {
+        sLog->outError("StartupLoader.Threads (%u) can't be higher than WorldDatabase.SynchThreads (%u), set to %u.",
+            m_int_configs[CONFIG_STARTUP_LOADER_THREADS], worldSynchConnections, worldSynchConnections);
+        m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = worldSynchConnections;
+    }
+    else if (!m_int_configs[CONFIG_STARTUP_LOADER_THREADS])
+        m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = worldSynchConnections;
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1297,15 +1312,20 @@ void World::SetInitialWorldSettings()
 
     sLog->outString("Loading Localization strings...");
     uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    {
+        // every locale table fills its own container
+        StartupLoader loader("Localization strings");
+        loader.Add("creature locales", sObjectMgr, &ObjectMgr::LoadCreatureLocales);
+        loader.Add("gameobject locales", sObjectMgr, &ObjectMgr::LoadGameObjectLocales);
+        loader.Add("item locales", sObjectMgr, &ObjectMgr::LoadItemLocales);
+        loader.Add("item set name locales", sObjectMgr, &ObjectMgr::LoadItemSetNameLocales);
+        loader.Add("quest locales", sObjectMgr, &ObjectMgr::LoadQuestLocales);
+        loader.Add("npc text locales", sObjectMgr, &ObjectMgr::LoadNpcTextLocales);
+        loader.Add("page text locales", sObjectMgr, &ObjectMgr::LoadPageTextLocales);
+        loader.Add("gossip menu item locales", sObjectMgr, &ObjectMgr::LoadGossipMenuItemsLocales);
+        loader.Add("point of interest locales", sObjectMgr, &ObjectMgr::LoadPointOfInterestLocales);
+        loader.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
     sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
@@ -1371,68 +1391,56 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading Equipment templates...");
     sObjectMgr->LoadEquipmentTemplates();
 
-    sLog->outString("Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
-
-    sLog->outString("Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
-
-    sLog->outString("Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
-
-    sLog->outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
-
-    sLog->outString("Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
-
-    sLog->outString("Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    sLog->outString("Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
-
-    sLog->outString("Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
-
-    sLog->outString("Loading pet levelup spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
-
-    sLog->outString("Loading pet default spells additional to levelup spells...");
-    sSpellMgr->LoadPetDefaultSpells();
-
-    sLog->outString("Loading Creature Template Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
-
-    sLog->outString("Loading Creature Respawn Data...");         // must be after PackInstances()
-    sObjectMgr->LoadCreatureRespawnTimes();
-
-    sLog->outString("Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
-
-    sLog->outString("Loading Gameobject Respawn Data...");       // must be after PackInstances()
-    sObjectMgr->LoadGameobjectRespawnTimes();
-
-    sLog->outString("Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
-
-    sLog->outString("Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
-
-    sLog->outString("Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog->outString("Checking Quest Disables");
-    DisableMgr::CheckQuestDisables();                           // must be after loading quests
-
-    sLog->outString("Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
-
-    sLog->outString("Loading Quests Relations...");
-    sObjectMgr->LoadQuestRelations();                            // must be after quest load
-
-    sLog->outString("Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
+    sLog->outString("Loading Creatures, Gameobjects, Quests and Pools...");
+    {
+        StartupLoader loader("Creatures, gameobjects, quests and pools");
+
+        StartupLoader::TaskId creatureTemplates = loader.Add("creature templates", sObjectMgr, &ObjectMgr::LoadCreatureTemplates);
+        StartupLoader::TaskId templateAddons = loader.Add("creature template addons", sObjectMgr, &ObjectMgr::LoadCreatureTemplateAddons);
+        loader.AddDependency(templateAddons, creatureTemplates);
+        loader.Add("reputation reward rates", sObjectMgr, &ObjectMgr::LoadReputationRewardRate);
+        StartupLoader::TaskId reputationOnKill = loader.Add("creature reputation on kill", sObjectMgr, &ObjectMgr::LoadReputationOnKill);
+        loader.AddDependency(reputationOnKill, creatureTemplates);
+        loader.Add("reputation spillover", sObjectMgr, &ObjectMgr::LoadReputationSpilloverTemplate);
+        loader.Add("points of interest", sObjectMgr, &ObjectMgr::LoadPointsOfInterest);
+        StartupLoader::TaskId baseStats = loader.Add("creature base stats", sObjectMgr, &ObjectMgr::LoadCreatureClassLevelStats);
+        loader.AddDependency(baseStats, creatureTemplates);                 // checks every template's level range
+
+        StartupLoader::TaskId creatures = loader.Add("creatures", sObjectMgr, &ObjectMgr::LoadCreatures);
+        loader.AddDependency(creatures, creatureTemplates);
+        loader.Add("pet levelup spells", sSpellMgr, &SpellMgr::LoadPetLevelupSpellMap);
+        StartupLoader::TaskId petDefaultSpells = loader.Add("pet default spells", sSpellMgr, &SpellMgr::LoadPetDefaultSpells);
+        loader.AddDependency(petDefaultSpells, creatureTemplates);
+        StartupLoader::TaskId creatureAddons = loader.Add("creature addons", sObjectMgr, &ObjectMgr::LoadCreatureAddons);
+        loader.AddDependency(creatureAddons, creatures);
+        loader.Add("creature respawn times", sObjectMgr, &ObjectMgr::LoadCreatureRespawnTimes);
+
+        // creatures and gameobjects are both added to the same map cell guid sets
+        StartupLoader::TaskId gameobjects = loader.Add("gameobjects", sObjectMgr, &ObjectMgr::LoadGameobjects);
+        loader.AddDependency(gameobjects, creatures);
+        loader.Add("gameobject respawn times", sObjectMgr, &ObjectMgr::LoadGameobjectRespawnTimes);
+        StartupLoader::TaskId linkedRespawn = loader.Add("creature linked respawn", sObjectMgr, &ObjectMgr::LoadLinkedRespawn);
+        loader.AddDependency(linkedRespawn, creatures);
+        loader.AddDependency(linkedRespawn, gameobjects);
+        loader.Add("weather data", &WeatherMgr::LoadWeatherData);
+
+        StartupLoader::TaskId quests = loader.Add("quests", sObjectMgr, &ObjectMgr::LoadQuests);
+        loader.AddDependency(quests, creatureTemplates);
+        StartupLoader::TaskId questDisables = loader.Add("quest disables", &DisableMgr::CheckQuestDisables);
+        loader.AddDependency(questDisables, quests);
+        StartupLoader::TaskId questPOI = loader.Add("quest POI", sObjectMgr, &ObjectMgr::LoadQuestPOI);
+        loader.AddDependency(questPOI, quests);
+        StartupLoader::TaskId questRelations = loader.Add("quest relations", sObjectMgr, &ObjectMgr::LoadQuestRelations);
+        loader.AddDependency(questRelations, quests);
+
+        // pools check the spawns and quests they contain, and take over the pooled quest relations
+        StartupLoader::TaskId pools = loader.Add("pools", sPoolMgr, &PoolMgr::LoadFromDB);
+        loader.AddDependency(pools, creatures);
+        loader.AddDependency(pools, gameobjects);
+        loader.AddDependency(pools, questRelations);
+
+        loader.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
     sLog->outString("Loading Game Event Data...");               // must be after loading pools fully
     sGameEventMgr->LoadFromDB();
@@ -1521,17 +1529,18 @@ void World::SetInitialWorldSettings()
     sObjectMgr->LoadFishingBaseSkillLevel();
 
     sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    {
+        StartupLoader loader("Achievements");
+        loader.Add("achievement reference list", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList);
+        StartupLoader::TaskId criteriaList = loader.Add("achievement criteria lists", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList);
+        StartupLoader::TaskId criteriaData = loader.Add("achievement criteria data", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaData);
+        StartupLoader::TaskId rewards = loader.Add("achievement rewards", sAchievementMgr, &AchievementGlobalMgr::LoadRewards);
+        StartupLoader::TaskId rewardLocales = loader.Add("achievement reward locales", sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales);
+        loader.Add("completed achievements", sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements);
+        loader.AddDependency(criteriaData, criteriaList);
+        loader.AddDependency(rewardLocales, rewards);          // locales are only kept for existing rewards
+        loader.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
     // Delete expired auctions before loading
     sLog->outString("Deleting expired auctions...");
@@ -31,6 +31,8 @@ EndScriptData */
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "GossipDef.h"
+#include "VMapFactory.h"
+#include "Spell.h"
 
 #include <fstream>
 
@@ -88,6 +90,9 @@ public:
             { "update",         SEC_ADMINISTRATOR,  false, &HandleDebugUpdateCommand,          "", NULL },
             { "itemexpire",     SEC_ADMINISTRATOR,  false, &HandleDebugItemExpireCommand,      "", NULL },
             { "areatriggers",   SEC_ADMINISTRATOR,  false, &HandleDebugAreaTriggersCommand,    "", NULL },
+            { "vmapcache",      SEC_ADMINISTRATOR,  true,  &HandleDebugVMapCacheCommand,       "", NULL },
+            { "objectlookups",  SEC_ADMINISTRATOR,  true,  &HandleDebugObjectLookupsCommand,   "", NULL },
+            { "mapstats",       SEC_ADMINISTRATOR,  false, &HandleDebugMapStatsCommand,        "", NULL },
             { NULL,             0,                  false, NULL,                               "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -1245,6 +1250,47 @@ public:
         return true;
     }
 
+    static bool HandleDebugVMapCacheCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        VMAP::VMapCacheStats stats;
+        VMAP::VMapFactory::createOrGetVMapManager()->getCacheStats(stats);
+
+        uint64 losTotal = stats.losHits + stats.losMisses;
+        uint64 heightTotal = stats.heightHits + stats.heightMisses;
+        handler->PSendSysMessage("LoS cache: " UI64FMTD " hits, " UI64FMTD " misses (%.1f%%), saved " UI64FMTD " ms",
+            stats.losHits, stats.losMisses, losTotal ? float(stats.losHits) * 100.0f / losTotal : 0.0f, stats.losSavedTime / 1000);
+        handler->PSendSysMessage("Height cache: " UI64FMTD " hits, " UI64FMTD " misses (%.1f%%), saved " UI64FMTD " ms",
+            stats.heightHits, stats.heightMisses, heightTotal ? float(stats.heightHits) * 100.0f / heightTotal : 0.0f, stats.heightSavedTime / 1000);
+        return true;
+    }
+
+    static bool HandleDebugObjectLookupsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        handler->PSendSysMessage("Global object lookups: players %ld, creatures %ld, pets %ld, gameobjects %ld, dynamicobjects %ld, corpses %ld",
+            HashMapHolder<Player>::GetFinds(), HashMapHolder<Creature>::GetFinds(), HashMapHolder<Pet>::GetFinds(),
+            HashMapHolder<GameObject>::GetFinds(), HashMapHolder<DynamicObject>::GetFinds(), HashMapHolder<Corpse>::GetFinds());
+        handler->PSendSysMessage("Contended object lookups: players %ld, creatures %ld, pets %ld, gameobjects %ld, dynamicobjects %ld, corpses %ld",
+            HashMapHolder<Player>::GetContendedFinds(), HashMapHolder<Creature>::GetContendedFinds(), HashMapHolder<Pet>::GetContendedFinds(),
+            HashMapHolder<GameObject>::GetContendedFinds(), HashMapHolder<DynamicObject>::GetContendedFinds(), HashMapHolder<Corpse>::GetContendedFinds());
+
+        if (Player* player = handler->GetSession() ? handler->GetSession()->GetPlayer() : NULL)
+            handler->PSendSysMessage("Local object lookups on map %u (instance %u): " UI64FMTD,
+                player->GetMapId(), player->GetInstanceId(), player->GetMap()->GetLocalObjectLookups());
+        return true;
+    }
+
+    static bool HandleDebugMapStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+        uint32 creatures, dormant;
+        map->GetCreatureCounts(creatures, dormant);
+        handler->PSendSysMessage("Map %u (instance %u): %u creatures in world, %u of them dormant, %u creatures waiting to respawn",
+            map->GetId(), map->GetInstanceId(), creatures, dormant, map->GetPendingRespawnCount());
+        handler->PSendSysMessage("Spell objects (all maps): %ld allocated from the heap, %ld reused from free lists",
+            Spell::GetHeapAllocations(), Spell::GetReusedAllocations());
+        return true;
+    }
+
     static bool HandleDebugSet32BitCommand(ChatHandler* handler, char const* args)
     {
         if (!*args)
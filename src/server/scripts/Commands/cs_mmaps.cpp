@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* ScriptData
+Name: mmaps_commandscript
+%Complete: 100
+Comment: Movement map (navmesh) related commands
+Category: commandscripts
+EndScriptData */
+
+#include "ScriptMgr.h"
+#include "Chat.h"
+#include "MMapFactory.h"
+
+class mmaps_commandscript : public CommandScript
+{
+public:
+    mmaps_commandscript() : CommandScript("mmaps_commandscript") { }
+
+    ChatCommand* GetCommands() const
+    {
+        static ChatCommand mmapCommandTable[] =
+        {
+            { "stats",          SEC_GAMEMASTER,     true,  &HandleMmapStatsCommand,            "", NULL },
+            { NULL,             0,                  false, NULL,                               "", NULL }
+        };
+        static ChatCommand commandTable[] =
+        {
+            { "mmap",           SEC_GAMEMASTER,     true,  NULL,                  "", mmapCommandTable },
+            { NULL,             0,                  false, NULL,                               "", NULL }
+        };
+        return commandTable;
+    }
+
+    static bool HandleMmapStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        MMAP::MMapStats stats;
+        MMAP::MMapFactory::createOrGetMMapManager()->getStats(stats);
+
+        handler->PSendSysMessage("mmap stats:");
+        handler->PSendSysMessage(" loaded maps: %u, loaded tiles: %u", stats.loadedMaps, stats.loadedTiles);
+        if (stats.memoryBudget)
+            handler->PSendSysMessage(" tile memory: " UI64FMTD " KB of " UI64FMTD " KB", stats.loadedBytes / 1024, stats.memoryBudget / 1024);
+        else
+            handler->PSendSysMessage(" tile memory: " UI64FMTD " KB, no budget", stats.loadedBytes / 1024);
+        handler->PSendSysMessage(" tile loads: %u, evictions: %u", stats.tileLoads, stats.tileEvictions);
+        handler->PSendSysMessage(" tile load time: avg %u us, max %u us",
+            stats.tileLoads ? uint32(stats.totalLoadTime / stats.tileLoads) : 0, stats.maxLoadTime);
+        return true;
+    }
+};
+
+void AddSC_mmaps_commandscript()
+{
+    new mmaps_commandscript();
+}
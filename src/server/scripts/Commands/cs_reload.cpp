@@ -1155,6 +1155,7 @@ public:
     {
         sLog->outString("Re-Loading Locales Item ... ");
         sObjectMgr->LoadItemLocales();
+        sAuctionMgr->ClearSearchNames();
         handler->SendGlobalGMSysMessage("DB table `locales_item` reloaded.");
         return true;
     }
@@ -19,8 +19,57 @@
 #include "Cryptography/BigNumber.h"
 #include <openssl/bn.h>
 #include <openssl/crypto.h>
+#include <ace/TSS_T.h>
 #include <algorithm>
 
+// Scratch space of a thread's BigNumber operations. OpenSSL contexts are costly to
+// set up and the SRP6 math runs several operations per login, so they are kept around.
+class BigNumberContext
+{
+    public:
+        BigNumberContext() : _ctx(BN_CTX_new()), _mont(NULL), _montModulus(BN_new()) { }
+
+        ~BigNumberContext()
+        {
+            BN_CTX_free(_ctx);
+            if (_mont)
+                BN_MONT_CTX_free(_mont);
+            BN_free(_montModulus);
+        }
+
+        BN_CTX* Get() { return _ctx; }
+
+        // Montgomery context of the last odd modulus used; authentication always uses the same N
+        BN_MONT_CTX* GetMont(const BIGNUM* modulus)
+        {
+            if (!BN_is_odd(modulus))
+                return NULL;
+
+            if (_mont && BN_cmp(modulus, _montModulus) == 0)
+                return _mont;
+
+            if (!_mont)
+                _mont = BN_MONT_CTX_new();
+
+            if (!_mont || !BN_MONT_CTX_set(_mont, modulus, _ctx) || !BN_copy(_montModulus, modulus))
+            {
+                if (_mont)
+                    BN_MONT_CTX_free(_mont);
+                _mont = NULL;
+            }
+
+            return _mont;
+        }
+
+    private:
+        BN_CTX* _ctx;
+        BN_MONT_CTX* _mont;
+        BIGNUM* _montModulus;
+};
+
+typedef ACE_TSS<BigNumberContext> BigNumberContextTSS;
+static BigNumberContextTSS bnContext;
+
 BigNumber::BigNumber()
     : _bn(BN_new())
     , _array(NULL)
@@ -73,7 +122,7 @@ void BigNumber::SetRand(int numbits)
     BN_rand(_bn, numbits, 0, 1);
 }
 
-BigNumber BigNumber::operator=(const BigNumber &bn)
+BigNumber& BigNumber::operator=(const BigNumber &bn)
 {
     if (this == &bn)
         return *this;
@@ -81,47 +130,35 @@ BigNumber BigNumber::operator=(const BigNumber &bn)
     return *this;
 }
 
-BigNumber BigNumber::operator+=(const BigNumber &bn)
+BigNumber& BigNumber::operator+=(const BigNumber &bn)
 {
     BN_add(_bn, _bn, bn._bn);
     return *this;
 }
 
-BigNumber BigNumber::operator-=(const BigNumber &bn)
+BigNumber& BigNumber::operator-=(const BigNumber &bn)
 {
     BN_sub(_bn, _bn, bn._bn);
     return *this;
 }
 
-BigNumber BigNumber::operator*=(const BigNumber &bn)
+BigNumber& BigNumber::operator*=(const BigNumber &bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mul(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mul(_bn, _bn, bn._bn, bnContext->Get());
 
     return *this;
 }
 
-BigNumber BigNumber::operator/=(const BigNumber &bn)
+BigNumber& BigNumber::operator/=(const BigNumber &bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_div(_bn, NULL, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_div(_bn, NULL, _bn, bn._bn, bnContext->Get());
 
     return *this;
 }
 
-BigNumber BigNumber::operator%=(const BigNumber &bn)
+BigNumber& BigNumber::operator%=(const BigNumber &bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod(_bn, _bn, bn._bn, bnContext->Get());
 
     return *this;
 }
@@ -129,11 +166,7 @@ BigNumber BigNumber::operator%=(const BigNumber &bn)
 BigNumber BigNumber::Exp(const BigNumber &bn)
 {
     BigNumber ret;
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_exp(ret._bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_exp(ret._bn, _bn, bn._bn, bnContext->Get());
 
     return ret;
 }
@@ -141,11 +174,10 @@ BigNumber BigNumber::Exp(const BigNumber &bn)
 BigNumber BigNumber::ModExp(const BigNumber &bn1, const BigNumber &bn2)
 {
     BigNumber ret;
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnctx);
-    BN_CTX_free(bnctx);
+    if (BN_MONT_CTX* mont = bnContext->GetMont(bn2._bn))
+        BN_mod_exp_mont(ret._bn, _bn, bn1._bn, bn2._bn, bnContext->Get(), mont);
+    else
+        BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnContext->Get());
 
     return ret;
 }
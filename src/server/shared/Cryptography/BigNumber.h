@@ -38,33 +38,33 @@ class BigNumber
 
         void SetRand(int numbits);
 
-        BigNumber operator=(const BigNumber &bn);
+        BigNumber& operator=(const BigNumber &bn);
 
-        BigNumber operator+=(const BigNumber &bn);
+        BigNumber& operator+=(const BigNumber &bn);
         BigNumber operator+(const BigNumber &bn)
         {
             BigNumber t(*this);
             return t += bn;
         }
-        BigNumber operator-=(const BigNumber &bn);
+        BigNumber& operator-=(const BigNumber &bn);
         BigNumber operator-(const BigNumber &bn)
         {
             BigNumber t(*this);
             return t -= bn;
         }
-        BigNumber operator*=(const BigNumber &bn);
+        BigNumber& operator*=(const BigNumber &bn);
         BigNumber operator*(const BigNumber &bn)
         {
             BigNumber t(*this);
             return t *= bn;
         }
-        BigNumber operator/=(const BigNumber &bn);
+        BigNumber& operator/=(const BigNumber &bn);
         BigNumber operator/(const BigNumber &bn)
         {
             BigNumber t(*this);
             return t /= bn;
         }
-        BigNumber operator%=(const BigNumber &bn);
+        BigNumber& operator%=(const BigNumber &bn);
         BigNumber operator%(const BigNumber &bn)
         {
             BigNumber t(*this);
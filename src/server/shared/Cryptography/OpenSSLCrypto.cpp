@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpenSSLCrypto.h"
+#include <openssl/crypto.h>
+#include <ace/Thread.h>
+#include <ace/Thread_Mutex.h>
+#include <vector>
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+
+static std::vector<ACE_Thread_Mutex*> cryptoLocks;
+
+static void lockingCallback(int mode, int type, char const* /*file*/, int /*line*/)
+{
+    if (mode & CRYPTO_LOCK)
+        cryptoLocks[type]->acquire();
+    else
+        cryptoLocks[type]->release();
+}
+
+static unsigned long threadIdCallback()
+{
+    return (unsigned long)ACE_Thread::self();
+}
+
+void OpenSSLCrypto::threadsSetup()
+{
+    cryptoLocks.resize(CRYPTO_num_locks());
+    for (int i = 0; i < CRYPTO_num_locks(); ++i)
+        cryptoLocks[i] = new ACE_Thread_Mutex();
+
+    CRYPTO_set_id_callback(threadIdCallback);
+    CRYPTO_set_locking_callback(lockingCallback);
+}
+
+void OpenSSLCrypto::threadsCleanup()
+{
+    CRYPTO_set_locking_callback(NULL);
+    CRYPTO_set_id_callback(NULL);
+
+    for (int i = 0; i < CRYPTO_num_locks(); ++i)
+        delete cryptoLocks[i];
+    cryptoLocks.clear();
+}
+
+#else
+
+// 1.1 and later lock internally
+void OpenSSLCrypto::threadsSetup() { }
+void OpenSSLCrypto::threadsCleanup() { }
+
+#endif
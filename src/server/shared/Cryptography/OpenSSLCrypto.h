@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _OPENSSL_CRYPTO_H
+#define _OPENSSL_CRYPTO_H
+
+// OpenSSL before 1.1 is only thread safe once the application gives it locks and a way
+// to tell threads apart. Set up before the first crypto call from a second thread.
+namespace OpenSSLCrypto
+{
+    void threadsSetup();
+    void threadsCleanup();
+}
+
+#endif
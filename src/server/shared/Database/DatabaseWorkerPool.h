@@ -418,6 +418,12 @@ class DatabaseWorkerPool
             delete[] buf;
         }
 
+        //! Number of connections available to synchronous queries, each one serves a single thread at a time.
+        uint32 GetSynchConnectionCount() const
+        {
+            return m_connectionCount[IDX_SYNCH];
+        }
+
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive()
         {
@@ -56,7 +56,7 @@ enum LoginDatabaseStatements
     LOGIN_SET_FAILEDLOGINS,
     LOGIN_GET_FAILEDLOGINS,
     LOGIN_GET_ACCIDBYNAME,
-    LOGIN_GET_NUMCHARSONREALM,
+    LOGIN_GET_NUMCHARSONREALMS,
     LOGIN_GET_ACCOUNT_BY_IP,
     LOGIN_SET_IP_BANNED,
     LOGIN_SET_IP_NOT_BANNED,
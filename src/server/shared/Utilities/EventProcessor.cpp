@@ -35,12 +35,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    m_events.Advance(m_time);
+    while (EventList::Node* node = m_events.GetDue())
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = node->Value;
+        m_events.Cancel(node);
 
         if (!Event->to_Abort)
         {
@@ -64,32 +64,32 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (EventList::Node* i = m_events.GetFirst(); i;)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        EventList::Node* i_old = i;
+        i = i->GetNext();
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        i_old->Value->to_Abort = true;
+        i_old->Value->Abort(m_time);
+        if (force || i_old->Value->IsDeletable())
         {
-            delete i_old->second;
+            delete i_old->Value;
 
             if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+                m_events.Cancel(i_old);
         }
     }
 
     // fast clear event list (in force case)
     if (force)
-        m_events.clear();
+        m_events.Clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
     if (set_addtime) Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    m_events.Schedule(e_time, Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
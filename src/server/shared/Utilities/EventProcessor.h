@@ -20,8 +20,7 @@
 #define __EVENTPROCESSOR_H
 
 #include "Define.h"
-
-#include<map>
+#include "TimerWheel.h"
 
 // Note. All times are in milliseconds here.
 
@@ -50,7 +49,7 @@ class BasicEvent
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+typedef TimerWheel<BasicEvent*> EventList;
 
 class EventProcessor
 {
@@ -62,6 +61,7 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
+        bool Empty() const { return m_events.Empty(); }
     protected:
         uint64 m_time;
         EventList m_events;
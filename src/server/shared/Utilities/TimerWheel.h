@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TIMERWHEEL_H
+#define TRINITY_TIMERWHEEL_H
+
+#include "Define.h"
+
+#include <vector>
+
+/*
+ * Hierarchical timer wheel used by EventProcessor.
+ *
+ * Scheduled values live in pooled nodes, a node is placed in the level whose
+ * slots still share the current time's higher bits and is handed down a level
+ * when the clock reaches its slot. Scheduling and cancelling are O(1), advancing
+ * only stops at occupied slots. Nodes whose time has been reached are kept in a
+ * due list ordered by time and then by scheduling order, so values scheduled for
+ * the same time come out in the order they went in.
+ *
+ * Times are in whatever unit the owner advances the wheel with, milliseconds
+ * for EventProcessor. The clock never runs backwards.
+ */
+template<class T>
+class TimerWheel
+{
+    enum
+    {
+        SLOT_BITS   = 4,
+        SLOTS       = 1 << SLOT_BITS,
+        SLOT_MASK   = SLOTS - 1,
+        LEVELS      = 6,                                // covers 2^24 ms (~4.6 hours), later nodes wait in the overflow list
+        BLOCK_NODES = 8,
+
+        LOCATION_OVERFLOW = LEVELS,
+        LOCATION_DUE      = LEVELS + 1
+    };
+
+    public:
+        class Node
+        {
+            friend class TimerWheel<T>;
+
+            public:
+                uint64 GetTime() const { return _time; }
+
+                // Next scheduled node, iteration over all nodes is in no particular order
+                Node* GetNext() const { return _allNext; }
+
+                T Value;
+
+            private:
+                uint64 _time;
+                uint64 _seq;
+                Node* _prev;                            // slot, overflow, due or free list
+                Node* _next;
+                Node* _allPrev;                         // all scheduled nodes
+                Node* _allNext;
+                uint8 _level;
+                uint8 _slot;
+        };
+
+        TimerWheel() : _now(0), _nextSeq(0), _nextStop(_NoStop()), _slots(NULL), _overflow(NULL), _dueHead(NULL), _dueTail(NULL),
+            _allHead(NULL), _free(NULL), _size(0)
+        {
+            for (uint8 level = 0; level < LEVELS; ++level)
+                _occupied[level] = 0;
+        }
+
+        ~TimerWheel()
+        {
+            Clear();
+            delete[] _slots;
+            for (typename std::vector<Node*>::iterator itr = _blocks.begin(); itr != _blocks.end(); ++itr)
+                delete[] *itr;
+        }
+
+        uint64 GetTime() const { return _now; }
+        uint32 Size() const { return _size; }
+        bool Empty() const { return _size == 0; }
+
+        // Schedules value at the given absolute time, times already reached are due at once
+        Node* Schedule(uint64 time, T const& value)
+        {
+            Node* node = _Acquire();
+            node->Value = value;
+            node->_time = time;
+            node->_seq = _nextSeq++;
+            _LinkAll(node);
+            _Place(node);
+            return node;
+        }
+
+        // Removes a scheduled node and returns it to the pool
+        void Cancel(Node* node)
+        {
+            _Unlink(node);
+            _UnlinkAll(node);
+            _Release(node);
+        }
+
+        // Moves the clock forward, every node scheduled up to time becomes due
+        void Advance(uint64 time)
+        {
+            while (_now < time)
+            {
+                // nothing to hand down or expire before time, nodes stay valid where they are
+                if (time < _nextStop)
+                {
+                    _now = time;
+                    return;
+                }
+
+                _now = _nextStop;
+
+                if (_overflow && !(_now & ((uint64(1) << (LEVELS * SLOT_BITS)) - 1)))
+                {
+                    Node* list = _overflow;
+                    _overflow = NULL;
+                    _PlaceList(list);
+                }
+
+                // levels whose lower bits just wrapped hand their current slot down, highest first
+                uint8 wrapped = 0;
+                while (wrapped + 1 < LEVELS && !(_now & ((uint64(1) << ((wrapped + 1) * SLOT_BITS)) - 1)))
+                    ++wrapped;
+                for (uint8 level = wrapped; level > 0; --level)
+                    _Cascade(level, uint8((_now >> (level * SLOT_BITS)) & SLOT_MASK));
+
+                _Cascade(0, uint8(_now & SLOT_MASK));
+                _nextStop = _NextStop();
+            }
+        }
+
+        // Earliest node whose time has been reached, NULL if none
+        Node* GetDue() const { return _dueHead; }
+
+        Node* GetFirst() const { return _allHead; }
+
+        // Returns every node to the pool, the clock is kept
+        void Clear()
+        {
+            while (_allHead)
+                Cancel(_allHead);
+        }
+
+    private:
+        TimerWheel(TimerWheel const& right);
+        TimerWheel& operator=(TimerWheel const& right);
+
+        static uint64 _NoStop() { return ~uint64(0); }
+
+        static bool _Before(Node const* left, Node const* right)
+        {
+            return left->_time < right->_time || (left->_time == right->_time && left->_seq < right->_seq);
+        }
+
+        static uint8 _LowestBit(uint32 mask)
+        {
+            // de Bruijn lookup of the lowest set bit, mask is never 0
+            static uint8 const table[32] =
+            {
+                0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+                31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+            };
+            return table[uint32((mask & (0 - mask)) * 0x077CB531U) >> 27];
+        }
+
+        // Next clock value at which a slot has to be expired or handed down
+        uint64 _NextStop() const
+        {
+            uint64 next = _overflow ? _OverflowStop() : _NoStop();
+
+            for (uint8 level = 0; level < LEVELS; ++level)
+            {
+                if (!_occupied[level])
+                    continue;
+
+                uint32 shift = level * SLOT_BITS;
+                uint32 current = uint32((_now >> shift) & SLOT_MASK);
+                uint32 pending = _occupied[level] & (~uint32(0) << (current + 1));
+                if (!pending)
+                    continue;
+
+                uint64 slotStart = ((_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS)) | (uint64(_LowestBit(pending)) << shift);
+                if (slotStart < next)
+                    next = slotStart;
+            }
+
+            return next;
+        }
+
+        uint64 _OverflowStop() const
+        {
+            return (_now | ((uint64(1) << (LEVELS * SLOT_BITS)) - 1)) + 1;
+        }
+
+        void _Cascade(uint8 level, uint8 slot)
+        {
+            if (!(_occupied[level] & (1 << slot)))
+                return;
+
+            Node*& head = _slots[level * SLOTS + slot];
+            Node* list = head;
+            head = NULL;
+            _occupied[level] &= ~(1 << slot);
+            _PlaceList(list);
+        }
+
+        void _PlaceList(Node* list)
+        {
+            while (list)
+            {
+                Node* node = list;
+                list = list->_next;
+                _Place(node);
+            }
+        }
+
+        void _Place(Node* node)
+        {
+            if (node->_time <= _now)
+            {
+                _InsertDue(node);
+                return;
+            }
+
+            for (uint8 level = 0; level < LEVELS; ++level)
+            {
+                uint32 shift = (level + 1) * SLOT_BITS;
+                if ((node->_time >> shift) != (_now >> shift))
+                    continue;
+
+                if (!_slots)
+                {
+                    _slots = new Node*[LEVELS * SLOTS];
+                    for (uint32 i = 0; i < LEVELS * SLOTS; ++i)
+                        _slots[i] = NULL;
+                }
+
+                uint8 slot = uint8((node->_time >> (level * SLOT_BITS)) & SLOT_MASK);
+                _PushFront(_slots[level * SLOTS + slot], node);
+                _occupied[level] |= 1 << slot;
+                node->_level = level;
+                node->_slot = slot;
+
+                uint64 slotStart = (node->_time >> (level * SLOT_BITS)) << (level * SLOT_BITS);
+                if (slotStart < _nextStop)
+                    _nextStop = slotStart;
+                return;
+            }
+
+            _PushFront(_overflow, node);
+            node->_level = LOCATION_OVERFLOW;
+            if (_OverflowStop() < _nextStop)
+                _nextStop = _OverflowStop();
+        }
+
+        void _InsertDue(Node* node)
+        {
+            // most nodes become due in order, look for the spot from the back
+            Node* after = _dueTail;
+            while (after && _Before(node, after))
+                after = after->_prev;
+
+            node->_prev = after;
+            node->_next = after ? after->_next : _dueHead;
+            if (node->_next)
+                node->_next->_prev = node;
+            else
+                _dueTail = node;
+            if (after)
+                after->_next = node;
+            else
+                _dueHead = node;
+
+            node->_level = LOCATION_DUE;
+        }
+
+        static void _PushFront(Node*& head, Node* node)
+        {
+            node->_prev = NULL;
+            node->_next = head;
+            if (head)
+                head->_prev = node;
+            head = node;
+        }
+
+        void _Unlink(Node* node)
+        {
+            if (node->_next)
+                node->_next->_prev = node->_prev;
+            else if (node->_level == LOCATION_DUE)
+                _dueTail = node->_prev;
+
+            if (node->_prev)
+            {
+                node->_prev->_next = node->_next;
+                return;
+            }
+
+            if (node->_level == LOCATION_DUE)
+                _dueHead = node->_next;
+            else if (node->_level == LOCATION_OVERFLOW)
+                _overflow = node->_next;
+            else
+            {
+                _slots[node->_level * SLOTS + node->_slot] = node->_next;
+                if (!node->_next)
+                    _occupied[node->_level] &= ~(1 << node->_slot);
+            }
+        }
+
+        void _LinkAll(Node* node)
+        {
+            node->_allPrev = NULL;
+            node->_allNext = _allHead;
+            if (_allHead)
+                _allHead->_allPrev = node;
+            _allHead = node;
+            ++_size;
+        }
+
+        void _UnlinkAll(Node* node)
+        {
+            if (node->_allNext)
+                node->_allNext->_allPrev = node->_allPrev;
+            if (node->_allPrev)
+                node->_allPrev->_allNext = node->_allNext;
+            else
+                _allHead = node->_allNext;
+            --_size;
+        }
+
+        Node* _Acquire()
+        {
+            if (!_free)
+            {
+                Node* block = new Node[BLOCK_NODES];
+                _blocks.push_back(block);
+                for (uint8 i = 0; i < BLOCK_NODES; ++i)
+                    _Release(&block[i]);
+            }
+
+            Node* node = _free;
+            _free = node->_next;
+            return node;
+        }
+
+        void _Release(Node* node)
+        {
+            node->Value = T();
+            node->_next = _free;
+            _free = node;
+        }
+
+        uint64 _now;
+        uint64 _nextSeq;
+        uint64 _nextStop;                               // may be early after a cancel, never late
+        Node** _slots;                                  // LEVELS * SLOTS list heads, allocated on first use
+        uint32 _occupied[LEVELS];                       // non-empty slots per level
+        Node* _overflow;
+        Node* _dueHead;
+        Node* _dueTail;
+        Node* _allHead;
+        Node* _free;
+        std::vector<Node*> _blocks;
+        uint32 _size;
+};
+
+#endif
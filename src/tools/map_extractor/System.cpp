@@ -4,6 +4,12 @@
 #include <deque>
 #include <set>
 #include <cstdlib>
+#include <string>
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/OS_NS_unistd.h>
 
 #ifdef _WIN32
 #include "direct.h"
@@ -70,6 +76,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// Number of threads converting ADT files, 0 - one per processor
+int   CONF_threads = 0;
+
 // List MPQ for extract from
 char *CONF_mpq_list[]={
     "common.MPQ",
@@ -116,6 +125,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting map files, one per processor by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -129,6 +139,7 @@ void HandleArgs(int argc, char * arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // t - number of converter threads
         if(arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -152,6 +163,16 @@ void HandleArgs(int argc, char * arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if(c + 1 < argc)                            // all ok
+                {
+                    CONF_threads=atoi(arg[(c++) + 1]);
+                    if(CONF_threads < 1)
+                        Usage(arg[0]);
+                }
+                else
+                    Usage(arg[0]);
+                break;
             case 'e':
                 if(c + 1 < argc)                            // all ok
                 {
@@ -349,27 +370,25 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-
-uint8 liquid_type[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-
-bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32 build)
+// Temporary grid data store, one per converter thread
+struct GridBuffers
 {
-    ADT_file adt;
-
-    if (!adt.loadFile(filename))
-        return false;
+    uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+    float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+
+    uint8 liquid_type[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+    bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+};
 
+bool ConvertADT(ADT_file &adt, char const* filename, char const* filename2, int cell_y, int cell_x, uint32 build, GridBuffers &grid)
+{
     adt_MCIN *cells = adt.a_grid->getMCIN();
     if (!cells)
     {
@@ -377,8 +396,8 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
         return false;
     }
 
-    memset(liquid_show, 0, sizeof(liquid_show));
-    memset(liquid_type, 0, sizeof(liquid_type));
+    memset(grid.liquid_show, 0, sizeof(grid.liquid_show));
+    memset(grid.liquid_type, 0, sizeof(grid.liquid_type));
 
     // Prepare map header
     map_fileheader map;
@@ -397,24 +416,24 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
             {
                 if(areas[areaid] != 0xffff)
                 {
-                    area_flags[i][j] = areas[areaid];
+                    grid.area_flags[i][j] = areas[areaid];
                     continue;
                 }
                 printf("File: %s\nCan't find area flag for areaid %u [%d, %d].\n", filename, areaid, cell->ix, cell->iy);
             }
-            area_flags[i][j] = 0xffff;
+            grid.area_flags[i][j] = 0xffff;
         }
     }
     //============================================
     // Try pack area data
     //============================================
     bool fullAreaData = false;
-    uint32 areaflag = area_flags[0][0];
+    uint32 areaflag = grid.area_flags[0][0];
     for (int y=0;y<ADT_CELLS_PER_GRID;y++)
     {
         for(int x=0;x<ADT_CELLS_PER_GRID;x++)
         {
-            if(area_flags[y][x]!=areaflag)
+            if(grid.area_flags[y][x]!=areaflag)
             {
                 fullAreaData = true;
                 break;
@@ -431,7 +450,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     if (fullAreaData)
     {
         areaHeader.gridArea = 0;
-        map.areaMapSize+=sizeof(area_flags);
+        map.areaMapSize+=sizeof(grid.area_flags);
     }
     else
     {
@@ -455,12 +474,12 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
             // 18    19    20    21    22    23    24    25    26
             //    27    28    29    30    31    32    33    34
             // . . . . . . . .
-            // For better get height values merge it to V9 and V8 map
-            // V9 height map:
+            // For better get height values merge it to grid.V9 and grid.V8 map
+            // grid.V9 height map:
             // 1     2     3     4     5     6     7     8     9
             // 18    19    20    21    22    23    24    25    26
             // . . . . . . . .
-            // V8 height map:
+            // grid.V8 height map:
             //    10    11    12    13    14    15    16    17
             //    27    28    29    30    31    32    33    34
             // . . . . . . . .
@@ -472,7 +491,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                 for (int x=0; x <= ADT_CELL_SIZE; x++)
                 {
                     int cx = j*ADT_CELL_SIZE + x;
-                    V9[cy][cx]=cell->ypos;
+                    grid.V9[cy][cx]=cell->ypos;
                 }
             }
             for (int y=0; y < ADT_CELL_SIZE; y++)
@@ -481,31 +500,31 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                 for (int x=0; x < ADT_CELL_SIZE; x++)
                 {
                     int cx = j*ADT_CELL_SIZE + x;
-                    V8[cy][cx]=cell->ypos;
+                    grid.V8[cy][cx]=cell->ypos;
                 }
             }
             // Get custom height
             adt_MCVT *v = cell->getMCVT();
             if (!v)
                 continue;
-            // get V9 height map
+            // get grid.V9 height map
             for (int y=0; y <= ADT_CELL_SIZE; y++)
             {
                 int cy = i*ADT_CELL_SIZE + y;
                 for (int x=0; x <= ADT_CELL_SIZE; x++)
                 {
                     int cx = j*ADT_CELL_SIZE + x;
-                    V9[cy][cx]+=v->height_map[y*(ADT_CELL_SIZE*2+1)+x];
+                    grid.V9[cy][cx]+=v->height_map[y*(ADT_CELL_SIZE*2+1)+x];
                 }
             }
-            // get V8 height map
+            // get grid.V8 height map
             for (int y=0; y < ADT_CELL_SIZE; y++)
             {
                 int cy = i*ADT_CELL_SIZE + y;
                 for (int x=0; x < ADT_CELL_SIZE; x++)
                 {
                     int cx = j*ADT_CELL_SIZE + x;
-                    V8[cy][cx]+=v->height_map[y*(ADT_CELL_SIZE*2+1)+ADT_CELL_SIZE+1+x];
+                    grid.V8[cy][cx]+=v->height_map[y*(ADT_CELL_SIZE*2+1)+ADT_CELL_SIZE+1+x];
                 }
             }
         }
@@ -519,7 +538,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     {
         for(int x=0;x<ADT_GRID_SIZE;x++)
         {
-            float h = V8[y][x];
+            float h = grid.V8[y][x];
             if (maxHeight < h) maxHeight = h;
             if (minHeight > h) minHeight = h;
         }
@@ -528,7 +547,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     {
         for(int x=0;x<=ADT_GRID_SIZE;x++)
         {
-            float h = V9[y][x];
+            float h = grid.V9[y][x];
             if (maxHeight < h) maxHeight = h;
             if (minHeight > h) minHeight = h;
         }
@@ -539,12 +558,12 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     {
         for (int y=0; y<ADT_GRID_SIZE; y++)
             for(int x=0;x<ADT_GRID_SIZE;x++)
-                if (V8[y][x] < CONF_use_minHeight)
-                    V8[y][x] = CONF_use_minHeight;
+                if (grid.V8[y][x] < CONF_use_minHeight)
+                    grid.V8[y][x] = CONF_use_minHeight;
         for (int y=0; y<=ADT_GRID_SIZE; y++)
             for(int x=0;x<=ADT_GRID_SIZE;x++)
-                if (V9[y][x] < CONF_use_minHeight)
-                    V9[y][x] = CONF_use_minHeight;
+                if (grid.V9[y][x] < CONF_use_minHeight)
+                    grid.V9[y][x] = CONF_use_minHeight;
         if (minHeight < CONF_use_minHeight)
             minHeight = CONF_use_minHeight;
         if (maxHeight < CONF_use_minHeight)
@@ -592,24 +611,24 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
         {
             for (int y=0; y<ADT_GRID_SIZE; y++)
                 for(int x=0;x<ADT_GRID_SIZE;x++)
-                    uint8_V8[y][x] = uint8((V8[y][x] - minHeight) * step + 0.5f);
+                    grid.uint8_V8[y][x] = uint8((grid.V8[y][x] - minHeight) * step + 0.5f);
             for (int y=0; y<=ADT_GRID_SIZE; y++)
                 for(int x=0;x<=ADT_GRID_SIZE;x++)
-                    uint8_V9[y][x] = uint8((V9[y][x] - minHeight) * step + 0.5f);
-            map.heightMapSize+= sizeof(uint8_V9) + sizeof(uint8_V8);
+                    grid.uint8_V9[y][x] = uint8((grid.V9[y][x] - minHeight) * step + 0.5f);
+            map.heightMapSize+= sizeof(grid.uint8_V9) + sizeof(grid.uint8_V8);
         }
         else if (heightHeader.flags&MAP_HEIGHT_AS_INT16)
         {
             for (int y=0; y<ADT_GRID_SIZE; y++)
                 for(int x=0;x<ADT_GRID_SIZE;x++)
-                    uint16_V8[y][x] = uint16((V8[y][x] - minHeight) * step + 0.5f);
+                    grid.uint16_V8[y][x] = uint16((grid.V8[y][x] - minHeight) * step + 0.5f);
             for (int y=0; y<=ADT_GRID_SIZE; y++)
                 for(int x=0;x<=ADT_GRID_SIZE;x++)
-                    uint16_V9[y][x] = uint16((V9[y][x] - minHeight) * step + 0.5f);
-            map.heightMapSize+= sizeof(uint16_V9) + sizeof(uint16_V8);
+                    grid.uint16_V9[y][x] = uint16((grid.V9[y][x] - minHeight) * step + 0.5f);
+            map.heightMapSize+= sizeof(grid.uint16_V9) + sizeof(grid.uint16_V8);
         }
         else
-            map.heightMapSize+= sizeof(V9) + sizeof(V8);
+            map.heightMapSize+= sizeof(grid.V9) + sizeof(grid.V8);
     }
 
     // Get liquid map for grid (in WOTLK used MH2O chunk)
@@ -634,7 +653,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                         int cx = j*ADT_CELL_SIZE + x + h->xOffset;
                         if (show & 1)
                         {
-                            liquid_show[cy][cx] = true;
+                            grid.liquid_show[cy][cx] = true;
                             ++count;
                         }
                         show>>=1;
@@ -644,10 +663,10 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                 uint32 type = LiqType[h->liquidType];
                 switch (type)
                 {
-                    case LIQUID_TYPE_WATER: liquid_type[i][j] |= MAP_LIQUID_TYPE_WATER; break;
-                    case LIQUID_TYPE_OCEAN: liquid_type[i][j] |= MAP_LIQUID_TYPE_OCEAN; break;
-                    case LIQUID_TYPE_MAGMA: liquid_type[i][j] |= MAP_LIQUID_TYPE_MAGMA; break;
-                    case LIQUID_TYPE_SLIME: liquid_type[i][j] |= MAP_LIQUID_TYPE_SLIME; break;
+                    case LIQUID_TYPE_WATER: grid.liquid_type[i][j] |= MAP_LIQUID_TYPE_WATER; break;
+                    case LIQUID_TYPE_OCEAN: grid.liquid_type[i][j] |= MAP_LIQUID_TYPE_OCEAN; break;
+                    case LIQUID_TYPE_MAGMA: grid.liquid_type[i][j] |= MAP_LIQUID_TYPE_MAGMA; break;
+                    case LIQUID_TYPE_SLIME: grid.liquid_type[i][j] |= MAP_LIQUID_TYPE_SLIME; break;
                     default:
                         printf("\nCan't find Liquid type %u for map %s\nchunk %d,%d\n", h->liquidType, filename, i, j);
                         break;
@@ -657,10 +676,10 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                 {
                     uint8 *lm = h2o->getLiquidLightMap(h);
                     if (!lm)
-                        liquid_type[i][j]|=MAP_LIQUID_TYPE_DARK_WATER;
+                        grid.liquid_type[i][j]|=MAP_LIQUID_TYPE_DARK_WATER;
                 }
 
-                if (!count && liquid_type[i][j])
+                if (!count && grid.liquid_type[i][j])
                     printf("Wrong liquid detect in MH2O chunk");
 
                 float *height = h2o->getLiquidHeightMap(h);
@@ -672,9 +691,9 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                     {
                         int cx = j*ADT_CELL_SIZE + x + h->xOffset;
                         if (height)
-                            liquid_height[cy][cx] = height[pos];
+                            grid.liquid_height[cy][cx] = height[pos];
                         else
-                            liquid_height[cy][cx] = h->heightLevel1;
+                            grid.liquid_height[cy][cx] = h->heightLevel1;
                         pos++;
                     }
                 }
@@ -705,9 +724,9 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                         int cx = j*ADT_CELL_SIZE + x;
                         if (liquid->flags[y][x] != 0x0F)
                         {
-                            liquid_show[cy][cx] = true;
+                            grid.liquid_show[cy][cx] = true;
                             if (liquid->flags[y][x]&(1<<7))
-                                liquid_type[i][j]|=MAP_LIQUID_TYPE_DARK_WATER;
+                                grid.liquid_type[i][j]|=MAP_LIQUID_TYPE_DARK_WATER;
                             ++count;
                         }
                     }
@@ -715,13 +734,13 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
 
                 uint32 c_flag = cell->flags;
                 if(c_flag & (1<<2))
-                    liquid_type[i][j]|=MAP_LIQUID_TYPE_WATER;            // water
+                    grid.liquid_type[i][j]|=MAP_LIQUID_TYPE_WATER;            // water
                 if(c_flag & (1<<3))
-                    liquid_type[i][j]|=MAP_LIQUID_TYPE_OCEAN;            // ochean
+                    grid.liquid_type[i][j]|=MAP_LIQUID_TYPE_OCEAN;            // ochean
                 if(c_flag & (1<<4))
-                    liquid_type[i][j]|=MAP_LIQUID_TYPE_MAGMA;            // magma/slime
+                    grid.liquid_type[i][j]|=MAP_LIQUID_TYPE_MAGMA;            // magma/slime
 
-                if (!count && liquid_type[i][j])
+                if (!count && grid.liquid_type[i][j])
                     printf("Wrong liquid detect in MCLQ chunk");
 
                 for (int y=0; y <= ADT_CELL_SIZE; y++)
@@ -730,7 +749,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                     for (int x=0; x<= ADT_CELL_SIZE; x++)
                     {
                         int cx = j*ADT_CELL_SIZE + x;
-                        liquid_height[cy][cx] = liquid->liquid[y][x].height;
+                        grid.liquid_height[cy][cx] = liquid->liquid[y][x].height;
                     }
                 }
             }
@@ -740,13 +759,13 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     //============================================
     // Pack liquid data
     //============================================
-    uint8 type = liquid_type[0][0];
+    uint8 type = grid.liquid_type[0][0];
     bool fullType = false;
     for (int y=0;y<ADT_CELLS_PER_GRID;y++)
     {
         for(int x=0;x<ADT_CELLS_PER_GRID;x++)
         {
-            if (liquid_type[y][x]!=type)
+            if (grid.liquid_type[y][x]!=type)
             {
                 fullType = true;
                 y = ADT_CELLS_PER_GRID;
@@ -774,18 +793,18 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
         {
             for(int x=0; x<ADT_GRID_SIZE; x++)
             {
-                if (liquid_show[y][x])
+                if (grid.liquid_show[y][x])
                 {
                     if (minX > x) minX = x;
                     if (maxX < x) maxX = x;
                     if (minY > y) minY = y;
                     if (maxY < y) maxY = y;
-                    float h = liquid_height[y][x];
+                    float h = grid.liquid_height[y][x];
                     if (maxHeight < h) maxHeight = h;
                     if (minHeight > h) minHeight = h;
                 }
                 else
-                    liquid_height[y][x] = CONF_use_minHeight;
+                    grid.liquid_height[y][x] = CONF_use_minHeight;
             }
         }
         map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
@@ -812,7 +831,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
         if (liquidHeader.flags & MAP_LIQUID_NO_TYPE)
             liquidHeader.liquidType = type;
         else
-            map.liquidMapSize+=sizeof(liquid_type);
+            map.liquidMapSize+=sizeof(grid.liquid_type);
 
         if (!(liquidHeader.flags & MAP_LIQUID_NO_HEIGHT))
             map.liquidMapSize += sizeof(float)*liquidHeader.width*liquidHeader.height;
@@ -829,7 +848,7 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     // Store area data
     fwrite(&areaHeader, sizeof(areaHeader), 1, output);
     if (!(areaHeader.flags&MAP_AREA_NO_AREA))
-        fwrite(area_flags, sizeof(area_flags), 1, output);
+        fwrite(grid.area_flags, sizeof(grid.area_flags), 1, output);
 
     // Store height data
     fwrite(&heightHeader, sizeof(heightHeader), 1, output);
@@ -837,18 +856,18 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     {
         if (heightHeader.flags & MAP_HEIGHT_AS_INT16)
         {
-            fwrite(uint16_V9, sizeof(uint16_V9), 1, output);
-            fwrite(uint16_V8, sizeof(uint16_V8), 1, output);
+            fwrite(grid.uint16_V9, sizeof(grid.uint16_V9), 1, output);
+            fwrite(grid.uint16_V8, sizeof(grid.uint16_V8), 1, output);
         }
         else if (heightHeader.flags & MAP_HEIGHT_AS_INT8)
         {
-            fwrite(uint8_V9, sizeof(uint8_V9), 1, output);
-            fwrite(uint8_V8, sizeof(uint8_V8), 1, output);
+            fwrite(grid.uint8_V9, sizeof(grid.uint8_V9), 1, output);
+            fwrite(grid.uint8_V8, sizeof(grid.uint8_V8), 1, output);
         }
         else
         {
-            fwrite(V9, sizeof(V9), 1, output);
-            fwrite(V8, sizeof(V8), 1, output);
+            fwrite(grid.V9, sizeof(grid.V9), 1, output);
+            fwrite(grid.V8, sizeof(grid.V8), 1, output);
         }
     }
 
@@ -857,11 +876,11 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     {
         fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
         if (!(liquidHeader.flags&MAP_LIQUID_NO_TYPE))
-            fwrite(liquid_type, sizeof(liquid_type), 1, output);
+            fwrite(grid.liquid_type, sizeof(grid.liquid_type), 1, output);
         if (!(liquidHeader.flags&MAP_LIQUID_NO_HEIGHT))
         {
             for (int y=0; y<liquidHeader.height;y++)
-                fwrite(&liquid_height[y+liquidHeader.offsetY][liquidHeader.offsetX], sizeof(float), liquidHeader.width, output);
+                fwrite(&grid.liquid_height[y+liquidHeader.offsetY][liquidHeader.offsetX], sizeof(float), liquidHeader.width, output);
         }
     }
     fclose(output);
@@ -869,6 +888,94 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     return true;
 }
 
+//**************************************************
+// Map conversion pipeline: this thread reads the ADT files from the MPQs
+// (libmpq can't be shared between threads) and converter threads turn them
+// into .map files. Every ADT has its own output file, so the output doesn't
+// depend on the order the converters finish in.
+//**************************************************
+struct ADTJob
+{
+    std::string mpqName;
+    std::string outputName;
+    int cellY;
+    int cellX;
+    uint8* data;
+    uint32 size;
+};
+
+// bounded, so the reader can't get far ahead of the converters and fill the memory
+class ADTJobQueue
+{
+public:
+    ADTJobQueue(size_t capacity) : _capacity(capacity), _closed(false), _notEmpty(_lock), _notFull(_lock) {}
+
+    void push(ADTJob* job)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+        while (_jobs.size() >= _capacity)
+            _notFull.wait();
+        _jobs.push_back(job);
+        _notEmpty.signal();
+    }
+
+    // NULL once the queue is closed and drained
+    ADTJob* pop()
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, NULL);
+        while (_jobs.empty() && !_closed)
+            _notEmpty.wait();
+        if (_jobs.empty())
+            return NULL;
+
+        ADTJob* job = _jobs.front();
+        _jobs.pop_front();
+        _notFull.signal();
+        return job;
+    }
+
+    void close()
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+        _closed = true;
+        _notEmpty.broadcast();
+    }
+
+private:
+    std::deque<ADTJob*> _jobs;
+    size_t _capacity;
+    bool _closed;
+    ACE_Thread_Mutex _lock;
+    ACE_Condition_Thread_Mutex _notEmpty;
+    ACE_Condition_Thread_Mutex _notFull;
+};
+
+class ADTConverterThreads : public ACE_Task_Base
+{
+public:
+    ADTConverterThreads(ADTJobQueue& queue, uint32 build) : _queue(queue), _build(build) {}
+
+    int svc()
+    {
+        GridBuffers* grid = new GridBuffers;
+        while (ADTJob* job = _queue.pop())
+        {
+            ADT_file adt;
+            if (adt.loadData(job->data, job->size))         // adt owns the data from here on
+                ConvertADT(adt, job->mpqName.c_str(), job->outputName.c_str(), job->cellY, job->cellX, _build, *grid);
+            else
+                printf("Error loading %s\n", job->mpqName.c_str());
+            delete job;
+        }
+        delete grid;
+        return 0;
+    }
+
+private:
+    ADTJobQueue& _queue;
+    uint32 _build;
+};
+
 void ExtractMapsFromMpq(uint32 build)
 {
     char mpq_filename[1024];
@@ -886,7 +993,22 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    int threads = CONF_threads;
+    if (threads < 1)
+    {
+        long processors = ACE_OS::num_processors_online();
+        threads = processors > 0 ? int(processors) : 1;
+    }
+
+    ADTJobQueue queue(threads * 4);
+    ADTConverterThreads converters(queue, build);
+    if (converters.activate(THR_NEW_LWP | THR_JOINABLE, threads) == -1)
+    {
+        printf("Can't start converter threads\n");
+        exit(1);
+    }
+
+    printf("Convert map files on %d threads\n", threads);
     for(uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%d)                  \n", map_ids[z].name, z+1, map_count);
@@ -907,12 +1029,33 @@ void ExtractMapsFromMpq(uint32 build)
                     continue;
                 sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
                 sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpq_filename, output_filename, y, x, build);
+
+                MPQFile mf(mpq_filename);
+                if(mf.isEof())
+                {
+                    printf("No such file %s\n", mpq_filename);
+                    continue;
+                }
+
+                ADTJob* job = new ADTJob;
+                job->mpqName = mpq_filename;
+                job->outputName = output_filename;
+                job->cellY = y;
+                job->cellX = x;
+                job->size = mf.getSize();
+                job->data = new uint8[job->size];
+                mf.read(job->data, job->size);
+                mf.close();
+                queue.push(job);
             }
             // draw progress bar
             printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
         }
     }
+    // let the converters finish what is queued, they still use areas and LiqType
+    queue.close();
+    converters.wait();
+
     printf("\n");
     delete [] areas;
     delete [] map_ids;
@@ -45,6 +45,18 @@ bool FileLoader::loadFile(char *filename, bool log)
     return false;
 }
 
+bool FileLoader::loadData(uint8 *fileData, uint32 fileSize)
+{
+    free();
+    data = fileData;
+    data_size = fileSize;
+    if (prepareLoadedData())
+        return true;
+
+    free();
+    return false;
+}
+
 bool FileLoader::prepareLoadedData()
 {
     // Check version
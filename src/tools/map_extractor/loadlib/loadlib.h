@@ -54,6 +54,8 @@ public:
     FileLoader();
     ~FileLoader();
     bool loadFile(char *filename, bool log = true);
+    // takes ownership of fileData, which must come from new[]
+    bool loadData(uint8 *fileData, uint32 fileSize);
     virtual void free();
 };
 #endif
@@ -25,13 +25,16 @@
 #include "DetourNavMeshBuilder.h"
 #include "DetourCommon.h"
 
+#include "Timer.h"
+
 using namespace VMAP;
 
 namespace Pathfinding
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath,
+        uint32 threads, bool incremental) :
     m_terrainBuilder(NULL),
         m_debugOutput        (debugOutput),
         m_skipContinents     (skipContinents),
@@ -40,7 +43,12 @@ namespace Pathfinding
         m_maxWalkableAngle   (maxWalkableAngle),
         m_bigBaseUnit        (bigBaseUnit),
         m_rcContext          (NULL),
-        m_offMeshFilePath    (offMeshFilePath)
+        m_offMeshFilePath    (offMeshFilePath),
+        m_threads            (threads ? threads : 1),
+        m_incremental        (incremental),
+        m_nextJob            (0),
+        m_builtTiles         (0),
+        m_skippedTiles       (0)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
@@ -142,12 +150,15 @@ namespace Pathfinding
     /**************************************************************************/
     void MapBuilder::buildAllMaps()
     {
+        // tiles of all maps share one queue, so small maps don't leave threads idle
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
-                buildMap(mapID);
+                queueMapTiles(mapID);
         }
+
+        processJobs();
     }
 
     /**************************************************************************/
@@ -193,23 +204,29 @@ namespace Pathfinding
     /**************************************************************************/
     void MapBuilder::buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY)
     {
-        dtNavMesh* navMesh = NULL;
-        buildNavMesh(mapID, navMesh);
-        if (!navMesh)
+        if (!buildNavMesh(mapID))
         {
             printf("Failed creating navmesh!              \n");
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh);
-        dtFreeNavMesh(navMesh);
+        if (m_incremental)
+            loadTileHashes(mapID);
+
+        queueTile(mapID, tileX, tileY);
+        processJobs();
     }
 
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
     {
-        printf("Building map %03u:\n", mapID);
+        if (queueMapTiles(mapID))
+            processJobs();
+    }
 
+    /**************************************************************************/
+    uint32 MapBuilder::queueMapTiles(uint32 mapID)
+    {
         set<uint32>* tiles = getTileList(mapID);
 
         // make sure we process maps which don't have tiles
@@ -226,19 +243,19 @@ namespace Pathfinding
         }
 
         if (!tiles->size())
-            return;
+            return 0;
 
         // build navMesh
-        dtNavMesh* navMesh = NULL;
-        buildNavMesh(mapID, navMesh);
-        if (!navMesh)
+        if (!buildNavMesh(mapID))
         {
-            printf("Failed creating navmesh!              \n");
-            return;
+            printf("Map %03u: failed creating navmesh!              \n", mapID);
+            return 0;
         }
 
-        // now start building mmtiles for each tile
-        printf("We have %u tiles.                          \n", (unsigned int)tiles->size());
+        if (m_incremental)
+            loadTileHashes(mapID);
+
+        uint32 count = 0;
         for (set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
         {
             uint32 tileX, tileY;
@@ -246,21 +263,89 @@ namespace Pathfinding
             // unpack tile coords
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-            if (shouldSkipTile(mapID, tileX, tileY))
+            // incremental mode decides once the tile inputs are loaded
+            if (!m_incremental && shouldSkipTile(mapID, tileX, tileY))
                 continue;
 
-            buildTile(mapID, tileX, tileY, navMesh);
+            queueTile(mapID, tileX, tileY);
+            ++count;
         }
 
-        dtFreeNavMesh(navMesh);
+        printf("Map %03u: queued %u of %u tiles.\n", mapID, count, (unsigned int)tiles->size());
+        return count;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::queueTile(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        TileJob job;
+        job.mapID = mapID;
+        job.tileX = tileX;
+        job.tileY = tileY;
+        m_jobs.push_back(job);
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::popJob(TileJob &job)
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, false);
+        if (m_nextJob >= m_jobs.size())
+            return false;
+
+        job = m_jobs[m_nextJob++];
+        return true;
+    }
+
+    /**************************************************************************/
+    int TileBuilderThreads::svc()
+    {
+        TileJob job;
+        while (m_builder->popJob(job))
+            m_builder->buildTile(job.mapID, job.tileX, job.tileY);
+
+        return 0;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::processJobs()
+    {
+        if (m_jobs.empty())
+            return;
 
-        printf("Complete!                               \n\n");
+        uint32 startTime = getMSTime();
+        m_nextJob = 0;
+        m_builtTiles = 0;
+        m_skippedTiles = 0;
+
+        uint32 threads = std::min<uint32>(m_threads, m_jobs.size());
+        printf("Building %u tiles on %u thread(s)...\n", (unsigned int)m_jobs.size(), threads);
+
+        if (threads > 1)
+        {
+            TileBuilderThreads workers(this);
+            if (workers.activate(threads) == -1)
+            {
+                printf("Failed starting worker threads, building on this one\n");
+                TileBuilderThreads(this).svc();
+            }
+            else
+                workers.wait();
+        }
+        else
+            TileBuilderThreads(this).svc();
+
+        if (m_incremental)
+            saveTileHashes();
+
+        printf("Complete! %u tiles built, %u unchanged, in %u s.            \n\n", m_builtTiles, m_skippedTiles, GetMSTimeDiffToNow(startTime) / 1000);
+        m_jobs.clear();
+        m_navMeshParams.clear();
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY)
     {
-        printf("Building map %03u, tile [%02u,%02u]\n", mapID, tileX, tileY);
+        uint32 startTime = getMSTime();
 
         MeshData meshData;
 
@@ -270,34 +355,181 @@ namespace Pathfinding
         // get model data
         m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
 
-        // if there is no data, give up now
-        if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-            return;
+        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
-        // remove unused vertices
-        TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
-        TerrainBuilder::cleanVertices(meshData.liquidVerts, meshData.liquidTris);
+        uint32 tileID = StaticMapTree::packTileID(tileX, tileY);
+        uint64 inputHash = 0;
+        if (m_incremental)
+        {
+            inputHash = hashTileInputs(meshData);
 
-        // gather all mesh data for final data check, and bounds calculation
-        G3D::Array<float> allVerts;
-        allVerts.append(meshData.liquidVerts);
-        allVerts.append(meshData.solidVerts);
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+            TileHashMap& hashes = m_tileHashes[mapID];
+            TileHashMap::const_iterator itr = hashes.find(tileID);
+            // a missing output file means someone removed it, build again
+            if (itr != hashes.end() && itr->second.hash == inputHash && (!itr->second.written || shouldSkipTile(mapID, tileX, tileY)))
+            {
+                ++m_skippedTiles;
+                return;
+            }
+        }
 
-        if (!allVerts.size())
+        bool written = false;
+        do
+        {
+            // if there is no data, give up now
+            if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
+                break;
+
+            // remove unused vertices
+            TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
+            TerrainBuilder::cleanVertices(meshData.liquidVerts, meshData.liquidTris);
+
+            // gather all mesh data for final data check, and bounds calculation
+            G3D::Array<float> allVerts;
+            allVerts.append(meshData.liquidVerts);
+            allVerts.append(meshData.solidVerts);
+
+            if (!allVerts.size())
+                break;
+
+            // get bounds of current tile
+            float bmin[3], bmax[3];
+            getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
+
+            // every tile gets its own navmesh, dtNavMesh isn't thread safe
+            dtNavMesh* navMesh = dtAllocNavMesh();
+            if (!navMesh || !navMesh->init(&m_navMeshParams[mapID]))
+            {
+                printf("[%02u,%02u]: Failed creating navmesh!              \n", tileX, tileY);
+                dtFreeNavMesh(navMesh);
+                break;
+            }
+
+            // build navmesh tile
+            written = buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+            dtFreeNavMesh(navMesh);
+        }
+        while (false);
+
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+        if (m_incremental)
+        {
+            TileInputHash& entry = m_tileHashes[mapID][tileID];
+            entry.hash = inputHash;
+            entry.written = written;
+        }
+
+        ++m_builtTiles;
+        printf("[%u/%u] Map %03u, tile [%02u,%02u] %s in %u ms\n", m_builtTiles + m_skippedTiles, (unsigned int)m_jobs.size(),
+            mapID, tileX, tileY, written ? "built" : "has no mesh", GetMSTimeDiffToNow(startTime));
+    }
+
+    // 64 bit FNV-1a, used to detect tiles whose inputs did not change
+    struct TileInputHasher
+    {
+        TileInputHasher() : hash(UI64LIT(14695981039346656037)) {}
+
+        void add(const void* data, size_t size)
+        {
+            const uint8* bytes = (const uint8*)data;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= UI64LIT(1099511628211);
+            }
+        }
+
+        template<class T>
+        void add(G3D::Array<T> &values)
+        {
+            uint32 size = values.size();
+            add(&size, sizeof(size));
+            if (size)
+                add(values.getCArray(), size * sizeof(T));
+        }
+
+        uint64 hash;
+    };
+
+    /**************************************************************************/
+    uint64 MapBuilder::hashTileInputs(MeshData &meshData)
+    {
+        // build settings first, then the loaded geometry
+        TileInputHasher hasher;
+
+        uint32 settings[4] = { MMAP_VERSION, DT_NAVMESH_VERSION, uint32(m_bigBaseUnit), uint32(m_terrainBuilder->usesLiquids()) };
+        hasher.add(settings, sizeof(settings));
+        hasher.add(&m_maxWalkableAngle, sizeof(m_maxWalkableAngle));
+        hasher.add(meshData.solidVerts);
+        hasher.add(meshData.solidTris);
+        hasher.add(meshData.liquidVerts);
+        hasher.add(meshData.liquidTris);
+        hasher.add(meshData.liquidType);
+        hasher.add(meshData.offMeshConnections);
+        hasher.add(meshData.offMeshConnectionRads);
+        hasher.add(meshData.offMeshConnectionDirs);
+        hasher.add(meshData.offMeshConnectionsAreas);
+        hasher.add(meshData.offMeshConnectionsFlags);
+        return hasher.hash;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::loadTileHashes(uint32 mapID)
+    {
+        TileHashMap& hashes = m_tileHashes[mapID];
+        hashes.clear();
+
+        char fileName[25];
+        sprintf(fileName, "mmaps/%03u.mmhash", mapID);
+        FILE* file = fopen(fileName, "r");
+        if (!file)
             return;
 
-        // get bounds of current tile
-        float bmin[3], bmax[3];
-        getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
+        // one line per tile: tileX tileY hash written
+        uint32 tileX, tileY, written;
+        uint64 hash;
+        while (fscanf(file, "%u %u " UI64FMTD " %u", &tileX, &tileY, &hash, &written) == 4)
+        {
+            TileInputHash& entry = hashes[StaticMapTree::packTileID(tileX, tileY)];
+            entry.hash = hash;
+            entry.written = written != 0;
+        }
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        fclose(file);
+    }
 
-        // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+    /**************************************************************************/
+    void MapBuilder::saveTileHashes()
+    {
+        for (map<uint32, TileHashMap>::iterator itr = m_tileHashes.begin(); itr != m_tileHashes.end(); ++itr)
+        {
+            char fileName[25];
+            sprintf(fileName, "mmaps/%03u.mmhash", itr->first);
+            FILE* file = fopen(fileName, "w");
+            if (!file)
+            {
+                char message[1024];
+                sprintf(message, "Failed to open %s for writing!\n", fileName);
+                perror(message);
+                continue;
+            }
+
+            for (TileHashMap::iterator hashItr = itr->second.begin(); hashItr != itr->second.end(); ++hashItr)
+            {
+                uint32 tileX, tileY;
+                StaticMapTree::unpackTileID(hashItr->first, tileX, tileY);
+                fprintf(file, "%u %u " UI64FMTD " %u\n", tileX, tileY, hashItr->second.hash, uint32(hashItr->second.written));
+            }
+
+            fclose(file);
+        }
+
+        m_tileHashes.clear();
     }
 
     /**************************************************************************/
-    void MapBuilder::buildNavMesh(uint32 mapID, dtNavMesh* &navMesh)
+    bool MapBuilder::buildNavMesh(uint32 mapID)
     {
         set<uint32>* tiles = getTileList(mapID);
 
@@ -346,13 +578,16 @@ namespace Pathfinding
         navMeshParams.maxTiles = maxTiles;
         navMeshParams.maxPolys = maxPolysPerTile;
 
-        navMesh = dtAllocNavMesh();
+        // check the params once here, workers build their own navmesh from them
+        dtNavMesh* navMesh = dtAllocNavMesh();
         printf("Creating navMesh...                     \r");
         if (!navMesh->init(&navMeshParams))
         {
+            dtFreeNavMesh(navMesh);
             printf("Failed creating navmesh!                \n");
-            return;
+            return false;
         }
+        dtFreeNavMesh(navMesh);
 
         char fileName[25];
         sprintf(fileName, "mmaps/%03u.mmap", mapID);
@@ -360,27 +595,28 @@ namespace Pathfinding
         FILE* file = fopen(fileName, "wb");
         if (!file)
         {
-            dtFreeNavMesh(navMesh);
             char message[1024];
             sprintf(message, "Failed to open %s for writing!\n", fileName);
             perror(message);
-            return;
+            return false;
         }
 
         // now that we know navMesh params are valid, we can write them to file
         fwrite(&navMeshParams, sizeof(dtNavMeshParams), 1, file);
         fclose(file);
+
+        m_navMeshParams[mapID] = navMeshParams;
+        return true;
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    bool MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
         // console output
-        char tileString[10];
-        sprintf(tileString, "[%02i,%02i]: ", tileX, tileY);
-        printf("%s Building movemap tiles...                        \r", tileString);
+        char tileString[20];
+        sprintf(tileString, "%03u [%02i,%02i]: ", mapID, tileX, tileY);
 
         IntermediateValues iv;
 
@@ -398,12 +634,13 @@ namespace Pathfinding
         // these are WORLD UNIT based metrics
         // this are basic unit dimentions
         // value have to divide GRID_SIZE(533.33333f) ( aka: 0.5333, 0.2666, 0.3333, 0.1333, etc )
-        const static float BASE_UNIT_DIM = m_bigBaseUnit ? 0.533333f : 0.266666f;
+        // not static, tiles are built concurrently
+        const float BASE_UNIT_DIM = m_bigBaseUnit ? 0.533333f : 0.266666f;
 
         // All are in UNIT metrics!
-        const static int VERTEX_PER_MAP = int(GRID_SIZE/BASE_UNIT_DIM + 0.5f);
-        const static int VERTEX_PER_TILE = m_bigBaseUnit ? 40 : 80; // must divide VERTEX_PER_MAP
-        const static int TILES_PER_MAP = VERTEX_PER_MAP/VERTEX_PER_TILE;
+        const int VERTEX_PER_MAP = int(GRID_SIZE/BASE_UNIT_DIM + 0.5f);
+        const int VERTEX_PER_TILE = m_bigBaseUnit ? 40 : 80; // must divide VERTEX_PER_MAP
+        const int TILES_PER_MAP = VERTEX_PER_MAP/VERTEX_PER_TILE;
 
         rcConfig config;
         memset(&config, 0, sizeof(rcConfig));
@@ -545,14 +782,14 @@ namespace Pathfinding
         if (!pmmerge)
         {
             printf("%s alloc pmmerge FIALED!          \r", tileString);
-            return;
+            return false;
         }
 
         rcPolyMeshDetail** dmmerge = new rcPolyMeshDetail*[TILES_PER_MAP * TILES_PER_MAP];
         if (!dmmerge)
         {
             printf("%s alloc dmmerge FIALED!          \r", tileString);
-            return;
+            return false;
         }
 
         int nmerge = 0;
@@ -574,7 +811,7 @@ namespace Pathfinding
         if (!iv.polyMesh)
         {
             printf("%s alloc iv.polyMesh FIALED!          \r", tileString);
-            return;
+            return false;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -582,7 +819,7 @@ namespace Pathfinding
         if (!iv.polyMeshDetail)
         {
             printf("%s alloc m_dmesh FIALED!          \r", tileString);
-            return;
+            return false;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -643,6 +880,7 @@ namespace Pathfinding
         // will hold final navmesh
         unsigned char* navData = NULL;
         int navDataSize = 0;
+        bool written = false;
 
         do
         {
@@ -682,7 +920,6 @@ namespace Pathfinding
                 continue;
             }
 
-            printf("%s Building navmesh tile...                \r", tileString);
             if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
             {
                 printf("%s Failed building navmesh tile!           \n", tileString);
@@ -690,7 +927,6 @@ namespace Pathfinding
             }
 
             dtTileRef tileRef = 0;
-            printf("%s Adding tile to navmesh...                \r", tileString);
             // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
             // is removed via removeTile()
             dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
@@ -713,8 +949,6 @@ namespace Pathfinding
                 continue;
             }
 
-            printf("%s Writing to file...                      \r", tileString);
-
             // write header
             MmapTileHeader header;
             header.usesLiquids = m_terrainBuilder->usesLiquids();
@@ -727,6 +961,7 @@ namespace Pathfinding
 
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, NULL, NULL);
+            written = true;
         }
         while (0);
 
@@ -743,6 +978,8 @@ namespace Pathfinding
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return written;
     }
 
     /**************************************************************************/
@@ -32,6 +32,9 @@
 #include "Recast.h"
 #include "DetourNavMesh.h"
 
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+
 using namespace std;
 using namespace VMAP;
 // G3D namespace typedefs conflicts with ACE typedefs
@@ -57,8 +60,42 @@ namespace Pathfinding
         rcPolyMeshDetail* dmesh;
     };
 
+    struct TileJob
+    {
+        uint32 mapID;
+        uint32 tileX;
+        uint32 tileY;
+    };
+
+    // hash of the inputs a tile was last built from, see incremental mode
+    struct TileInputHash
+    {
+        uint64 hash;
+        bool written;                                       // tile produced a .mmtile file
+    };
+    typedef map<uint32, TileInputHash> TileHashMap;         // packed tile id -> hash
+
+    class MapBuilder;
+
+    // worker threads pulling tiles off the builder's job queue
+    class TileBuilderThreads : protected ACE_Task_Base
+    {
+        public:
+            TileBuilderThreads(MapBuilder* builder) : m_builder(builder) {}
+
+            int activate(int threads) { return ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE, threads); }
+            int wait() { return ACE_Task_Base::wait(); }
+
+            int svc();
+
+        private:
+            MapBuilder* m_builder;
+    };
+
     class MapBuilder
     {
+        friend class TileBuilderThreads;
+
         public:
             MapBuilder(float maxWalkableAngle   = 60.f,
                 bool skipLiquid          = false,
@@ -67,7 +104,9 @@ namespace Pathfinding
                 bool skipBattlegrounds   = false,
                 bool debugOutput         = false,
                 bool bigBaseUnit         = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                uint32 threads           = 1,
+                bool incremental         = false);
 
             ~MapBuilder();
 
@@ -85,12 +124,25 @@ namespace Pathfinding
             void discoverTiles();
             set<uint32>* getTileList(uint32 mapID);
 
-            void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
+            // writes the map's navmesh parameters, false if the map has no tiles or they can't be stored
+            bool buildNavMesh(uint32 mapID);
+
+            // queues the map's tiles for the workers, returns queued count
+            uint32 queueMapTiles(uint32 mapID);
+            void queueTile(uint32 mapID, uint32 tileX, uint32 tileY);
+            // builds all queued tiles, on m_threads threads
+            void processJobs();
+            bool popJob(TileJob &job);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
-            // move map building
-            void buildMoveMapTile(uint32 mapID,
+            // incremental mode
+            uint64 hashTileInputs(MeshData &meshData);
+            void loadTileHashes(uint32 mapID);
+            void saveTileHashes();
+
+            // move map building, true if the tile was written
+            bool buildMoveMapTile(uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData &meshData,
@@ -122,6 +174,19 @@ namespace Pathfinding
 
             // build performance - not really used for now
             rcContext* m_rcContext;
+
+            uint32 m_threads;
+            bool m_incremental;
+
+            // navmesh params of every queued map, workers create their own navmesh from them
+            map<uint32, dtNavMeshParams> m_navMeshParams;
+            map<uint32, TileHashMap> m_tileHashes;
+            vector<TileJob> m_jobs;
+            uint32 m_nextJob;
+            uint32 m_builtTiles;
+            uint32 m_skippedTiles;
+            // guards the job queue, tile hashes and console output
+            ACE_Thread_Mutex m_lock;
     };
 }
 
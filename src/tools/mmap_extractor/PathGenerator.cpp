@@ -19,6 +19,8 @@
 #include "PathCommon.h"
 #include "MapBuilder.h"
 
+#include <ace/OS_NS_unistd.h>
+
 using namespace Pathfinding;
 
 bool checkDirectories(bool debugOutput)
@@ -70,7 +72,9 @@ bool handleArgs(int argc, char** argv,
                bool &debugOutput,
                bool &silent,
                bool &bigBaseUnit,
-               char* &offMeshInputPath)
+               char* &offMeshInputPath,
+               int &threads,
+               bool &incremental)
 {
     char* param = NULL;
     for (int i = 1; i < argc; ++i)
@@ -199,6 +203,31 @@ bool handleArgs(int argc, char** argv,
 
             offMeshInputPath = param;
         }
+        else if (strcmp(argv[i], "--threads") == 0)
+        {
+            param = argv[++i];
+            if (!param)
+                return false;
+
+            int count = atoi(param);
+            if (count > 0)
+                threads = count;
+            else
+                printf("invalid option for '--threads', using default\n");
+        }
+        else if (strcmp(argv[i], "--incremental") == 0)
+        {
+            param = argv[++i];
+            if (!param)
+                return false;
+
+            if (strcmp(param, "true") == 0)
+                incremental = true;
+            else if (strcmp(param, "false") == 0)
+                incremental = false;
+            else
+                printf("invalid option for '--incremental', using default false\n");
+        }
         else
         {
             int map = atoi(argv[i]);
@@ -233,13 +262,18 @@ int main(int argc, char** argv)
          skipBattlegrounds = false,
          debugOutput = false,
          silent = false,
-         bigBaseUnit = false;
+         bigBaseUnit = false,
+         incremental = false;
     char* offMeshInputPath = NULL;
+    // one tile per processor unless told otherwise
+    long processors = ACE_OS::num_processors_online();
+    int threads = processors > 0 ? int(processors) : 1;
 
     bool validParam = handleArgs(argc, argv, mapnum,
                                  tileX, tileY, maxAngle,
                                  skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds,
-                                 debugOutput, silent, bigBaseUnit, offMeshInputPath);
+                                 debugOutput, silent, bigBaseUnit, offMeshInputPath,
+                                 threads, incremental);
 
     if (!validParam)
         return silent ? -1 : finish("You have specified invalid parameters", -1);
@@ -260,7 +294,8 @@ int main(int argc, char** argv)
         return silent ? -3 : finish("Press any key to close...", -3);
 
     MapBuilder builder(maxAngle, skipLiquid, skipContinents, skipJunkMaps,
-                       skipBattlegrounds, debugOutput, bigBaseUnit, offMeshInputPath);
+                       skipBattlegrounds, debugOutput, bigBaseUnit, offMeshInputPath,
+                       uint32(threads), incremental);
 
     if (tileX > -1 && tileY > -1 && mapnum >= 0)
         builder.buildSingleTile(mapnum, tileX, tileY);
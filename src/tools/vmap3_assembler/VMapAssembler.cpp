@@ -1,23 +1,31 @@
 #include <string>
 #include <iostream>
+#include <cstdlib>
+
+#include <ace/OS_NS_unistd.h>
 
 #include "TileAssembler.h"
 
 int main(int argc, char* argv[])
 {
-    if(argc != 3)
+    if(argc != 3 && argc != 4)
     {
         //printf("\nusage: %s <raw data dir> <vmap dest dir> [config file name]\n", argv[0]);
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [threads]" << std::endl;
         return 1;
     }
 
     std::string src = argv[1];
     std::string dest = argv[2];
 
+    // model files are converted on one thread per processor by default
+    long threads = argc == 4 ? atol(argv[3]) : ACE_OS::num_processors_online();
+    if (threads < 1)
+        threads = 1;
+
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
-    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest, uint32(threads));
 
     if(!ta->convertWorld2())
     {
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replays line of sight queries against extracted vmaps, once ray by ray and
+ * once in packets, and reports the time both took and whether they agree.
+ *
+ * Every line of the query file holds one query in world coordinates:
+ *     <map id> <x1> <y1> <z1> <x2> <y2> <z2>
+ * Lines starting with '#' are skipped.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <ace/OS_NS_sys_time.h>
+#include <ace/Time_Value.h>
+
+#include "MapTree.h"
+#include "VMapManager2.h"
+
+using G3D::Vector3;
+
+namespace
+{
+    // same grid math as Map::EnsureGridCreated, vmap tiles are named after the swapped grid coords
+    int ComputeTile(float pos)
+    {
+        double offset = (double(pos) - 533.33333f / 2) / 533.33333f;
+        return 63 - int(offset + 32 + 0.5f);
+    }
+
+    struct MapQueries
+    {
+        std::vector<Vector3> From;
+        std::vector<Vector3> To;
+        std::set<std::pair<int, int> > Tiles;
+    };
+
+    uint64 ElapsedUSec(ACE_Time_Value const& start)
+    {
+        ACE_UINT64 usec;
+        (ACE_OS::gettimeofday() - start).to_usec(usec);
+        return usec;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3 && argc != 4)
+    {
+        printf("usage: %s <vmaps dir> <query file> [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    std::string basePath = argv[1];
+    int repeat = argc == 4 ? atoi(argv[3]) : 10;
+    if (repeat < 1)
+        repeat = 1;
+
+    FILE* input = fopen(argv[2], "r");
+    if (!input)
+    {
+        printf("could not open query file %s\n", argv[2]);
+        return 1;
+    }
+
+    VMAP::VMapManager2 manager;
+    std::map<uint32, MapQueries> queries;
+    char line[256];
+    uint32 lineNo = 0;
+    while (fgets(line, sizeof(line), input))
+    {
+        ++lineNo;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+            continue;
+
+        uint32 mapId;
+        float x1, y1, z1, x2, y2, z2;
+        if (sscanf(line, "%u %f %f %f %f %f %f", &mapId, &x1, &y1, &z1, &x2, &y2, &z2) != 7)
+        {
+            printf("skipping malformed line %u\n", lineNo);
+            continue;
+        }
+
+        // the same conversion and eye height offset the server applies before tracing
+        MapQueries& mapQueries = queries[mapId];
+        mapQueries.From.push_back(manager.convertPositionToInternalRep(x1, y1, z1 + 2.0f));
+        mapQueries.To.push_back(manager.convertPositionToInternalRep(x2, y2, z2 + 2.0f));
+        mapQueries.Tiles.insert(std::make_pair(ComputeTile(x1), ComputeTile(y1)));
+        mapQueries.Tiles.insert(std::make_pair(ComputeTile(x2), ComputeTile(y2)));
+    }
+    fclose(input);
+
+    uint64 totalSingle = 0;
+    uint64 totalPacket = 0;
+    uint32 totalQueries = 0;
+    uint32 mismatches = 0;
+    for (std::map<uint32, MapQueries>::const_iterator itr = queries.begin(); itr != queries.end(); ++itr)
+    {
+        MapQueries const& mapQueries = itr->second;
+        uint32 count = mapQueries.From.size();
+
+        VMAP::StaticMapTree tree(itr->first, basePath);
+        if (!tree.InitMap(VMAP::VMapManager2::getMapFileName(itr->first), &manager))
+        {
+            printf("map %u: could not load vmap, skipping %u queries\n", itr->first, count);
+            continue;
+        }
+
+        for (std::set<std::pair<int, int> >::const_iterator tile = mapQueries.Tiles.begin(); tile != mapQueries.Tiles.end(); ++tile)
+            tree.LoadMapTile(tile->first, tile->second, &manager);
+
+        std::vector<char> singleResults(count);
+        ACE_Time_Value start = ACE_OS::gettimeofday();
+        for (int i = 0; i < repeat; ++i)
+            for (uint32 q = 0; q < count; ++q)
+                singleResults[q] = tree.isInLineOfSight(mapQueries.From[q], mapQueries.To[q]);
+        uint64 single = ElapsedUSec(start);
+
+        bool* packetResults = new bool[count];
+        start = ACE_OS::gettimeofday();
+        for (int i = 0; i < repeat; ++i)
+            tree.isInLineOfSight(&mapQueries.From[0], &mapQueries.To[0], packetResults, count);
+        uint64 packet = ElapsedUSec(start);
+
+        uint32 mapMismatches = 0;
+        for (uint32 q = 0; q < count; ++q)
+            if (bool(singleResults[q]) != packetResults[q])
+                ++mapMismatches;
+        delete[] packetResults;
+
+        tree.UnloadMap(&manager);
+
+        printf("map %u: %u queries x %d, single rays %llu us, packets %llu us, %u mismatches\n",
+            itr->first, count, repeat, (unsigned long long)single, (unsigned long long)packet, mapMismatches);
+
+        totalSingle += single;
+        totalPacket += packet;
+        totalQueries += count;
+        mismatches += mapMismatches;
+    }
+
+    printf("total: %u queries x %d, single rays %llu us, packets %llu us, %u mismatches\n",
+        totalQueries, repeat, (unsigned long long)totalSingle, (unsigned long long)totalPacket, mismatches);
+    return mismatches ? 2 : 0;
+}